@@ -35,7 +35,6 @@ NS_LOG_COMPONENT_DEFINE("baseline");
 
 const std::string SSID_DATA_PREFIX = "ssid_data_";
 
-extern void PopulateArpCache();
 extern void experiment(uint32_t nStaNum, uint32_t nUdpMaxPktCount, bool rts, bool hidden);
 
 int main(int argc, char *argv[])
@@ -269,7 +268,8 @@ void experiment(uint32_t nStaNum, uint32_t nUdpMaxPktCount, bool rts, bool hidde
 	Ipv4InterfaceContainer ipIfContainerStaData = address.Assign(
 			staDataDevContainer);
 
-	PopulateArpCache();
+	ArpCacheHelper arpHelper;
+	arpHelper.PopulateStatic();
 
 	// setup UDP server
 	UdpServerHelper srvHelper(nPort);
@@ -446,77 +446,3 @@ void experiment(uint32_t nStaNum, uint32_t nUdpMaxPktCount, bool rts, bool hidde
 
 
 }
-
-void PopulateArpCache()
-{
-	// Creates ARP Cache object
-	Ptr<ArpCache> arp = CreateObject<ArpCache>();
-
-	// Set ARP Timeout
-	arp->SetAliveTimeout(Seconds(3600 * 24 * 365)); // 1-year
-
-	// Populates ARP Cache with information from all nodes
-	for (NodeList::Iterator i = NodeList::Begin(); i != NodeList::End(); ++i)
-	{
-		// Get an interactor to Ipv4L3Protocol instance
-		Ptr<Ipv4L3Protocol> ip = (*i)->GetObject<Ipv4L3Protocol>();
-		NS_ASSERT(ip !=0);
-
-		// Get interfaces list from Ipv4L3Protocol iteractor
-		ObjectVectorValue interfaces;
-		ip->GetAttribute("InterfaceList", interfaces);
-
-		// For each interface
-		for (ObjectVectorValue::Iterator j = interfaces.Begin();
-				j != interfaces.End(); j++)
-		{
-			// Get an interactor to Ipv4L3Protocol instance
-			Ptr<Ipv4Interface> ipIface =
-					(j->second)->GetObject<Ipv4Interface>();
-			NS_ASSERT(ipIface != 0);
-
-			// Get interfaces list from Ipv4L3Protocol iteractor
-			Ptr<NetDevice> device = ipIface->GetDevice();
-			NS_ASSERT(device != 0);
-
-			// Get MacAddress assigned to this device
-			Mac48Address addr = Mac48Address::ConvertFrom(device->GetAddress());
-
-			// For each Ipv4Address in the list of Ipv4Addresses assign to this interface...
-			for (uint32_t k = 0; k < ipIface->GetNAddresses(); k++)
-			{
-				// Get Ipv4Address
-				Ipv4Address ipAddr = ipIface->GetAddress(k).GetLocal();
-
-				// If Loopback address, go to the next
-				if (ipAddr == Ipv4Address::GetLoopback())
-					continue;
-
-				// Creates an ARP entry for this Ipv4Address and adds it to the ARP Cache
-				ArpCache::Entry * entry = arp->Add(ipAddr);
-				entry->MarkWaitReply(0);
-				entry->MarkAlive(addr);
-
-				NS_LOG_ERROR ("Arp Cache: Adding the pair (" << addr << "," << ipAddr << ")");
-
-			}
-		}
-	}
-
-	// Assign ARP Cache to each interface of each node
-	for (NodeList::Iterator i = NodeList::Begin(); i != NodeList::End(); ++i)
-	{
-		Ptr<Ipv4L3Protocol> ip = (*i)->GetObject<Ipv4L3Protocol>();
-		NS_ASSERT(ip !=0);
-		ObjectVectorValue interfaces;
-		ip->GetAttribute("InterfaceList", interfaces);
-		for (ObjectVectorValue::Iterator j = interfaces.Begin();
-				j != interfaces.End(); j++)
-		{
-			Ptr<Ipv4Interface> ipIface =
-					(j->second)->GetObject<Ipv4Interface>();
-			ipIface->SetAttribute("ArpCache", PointerValue(arp));
-		}
-	}
-}
-
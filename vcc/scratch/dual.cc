@@ -44,7 +44,7 @@ int main(int argc, char *argv[])
 	bool verbose = true;
 	uint32_t nSta = 4;
 	uint32_t nPort = 1987;
-	bool g_bGlobalFirstRts = true;
+	Ptr<CtrlRtsArbiter> rtsArbiter = CreateObject<CtrlRtsArbiter>();
 
 	if (verbose)
 	{
@@ -112,6 +112,11 @@ int main(int argc, char *argv[])
 	NodeContainer allNodes = wifiStaNodes;
 	allNodes.Add(wifiApNode);
 
+	// data/ctrl address registry shared by all the txops
+	Ptr<ChannelAddressRegistry> addrRegistry = CreateObject<
+			ChannelAddressRegistry>();
+	addrRegistry->Install(allNodes);
+
 	// setup callbacks for STA
 	for (uint32_t i = 0; i < wifiStaNodes.GetN(); ++i)
 	{
@@ -131,14 +136,14 @@ int main(int argc, char *argv[])
 		staDataDca->SetSendByCtrlChannleCallback(
 				MakeCallback(&CtrlDcaTxop::SendByCtrlChannelImpl, staCtrlDca));
 
-		// set global information for dataDcaTxop
-		staDataDca->SetGlobalRtsSignal(&g_bGlobalFirstRts);
+		// set ctrl RTS arbiter to dataDcaTxop
+		staDataDca->SetRtsArbiter(rtsArbiter);
 
-		// set topology to dataDcaTxop
-		staDataDca->SetNodeContainer(&allNodes);
+		// set address registry to dataDcaTxop
+		staDataDca->SetAddressRegistry(addrRegistry);
 
-		// set topology to ctrlDcaTxop
-		staCtrlDca->SetNodeContainer(&allNodes);
+		// set address registry to ctrlDcaTxop
+		staCtrlDca->SetAddressRegistry(addrRegistry);
 
 		// set callback for ctrlDcaTxop
 		staCtrlDca->SetNotifyDataChannelCallback(
@@ -165,14 +170,14 @@ int main(int argc, char *argv[])
 		apDataDca->SetSendByCtrlChannleCallback(
 				MakeCallback(&CtrlDcaTxop::SendByCtrlChannelImpl, apCtrlDca));
 
-		// set global information for dataDcaTxop
-		apDataDca->SetGlobalRtsSignal(&g_bGlobalFirstRts);
+		// set ctrl RTS arbiter to dataDcaTxop
+		apDataDca->SetRtsArbiter(rtsArbiter);
 
-		// set topology to dataDcaTxop
-		apDataDca->SetNodeContainer(&allNodes);
+		// set address registry to dataDcaTxop
+		apDataDca->SetAddressRegistry(addrRegistry);
 
-		// set topology to ctrlDcaTxop
-		apCtrlDca->SetNodeContainer(&allNodes);
+		// set address registry to ctrlDcaTxop
+		apCtrlDca->SetAddressRegistry(addrRegistry);
 
 		// set callback for ctrlDcaTxop
 		apCtrlDca->SetNotifyDataChannelCallback(
@@ -27,6 +27,14 @@
 #include "ns3/propagation-loss-model.h"
 #include "ns3/propagation-delay-model.h"
 
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cmath>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
 #define VALID_FLOW_COUNT 50
 
 // throughput evaluation
@@ -38,20 +46,113 @@ NS_LOG_COMPONENT_DEFINE("eva");
 const std::string SSID_DATA_PREFIX = "ssid_data_";
 const std::string SSID_CTRL_PREFIX = "ssid_ctrl_";
 
-extern void PopulateArpCache();
+/**
+ * the figures of one run of vcc() or baseline()
+ */
+struct EvaResult
+{
+	double throughput; // average throughput of the valid flows, in Mbps
+	double utility; // channel utility
+	uint32_t nFlows;
+	uint32_t nValidFlows; // flows with at least VALID_FLOW_COUNT packets received
+	uint64_t nTxPackets;
+	uint64_t nRxPackets;
+	double lastRxTime; // in seconds
+	uint64_t nRtsGrants; // ctrl channel RTS granted by the arbiter, vcc only
+	uint64_t nRtsDenies; // ctrl channel RTS denied by the arbiter, vcc only
+};
+
+/**
+ * the replications which go on from a snapshot of the same simulation,
+ * see the warmup option of the sweep
+ */
+struct WarmStart
+{
+	double time; // time of the snapshot in seconds, 0 for none
+	uint32_t nJobs; // branches run in parallel
+	std::vector<uint32_t> runs; // RngRun of each branch
+	std::vector<uint32_t> pkts; // packet count per station of each branch
+	bool bParent; // set in the process which took the snapshot
+};
+
 extern void vcc(uint32_t nStaNum, uint32_t nUdpMaxPktCount,
-		uint32_t nUdpPktSize, bool rts, bool hidden);
+		uint32_t nUdpPktSize, bool rts, bool hidden, EvaResult *pResult = 0);
 extern void baseline(uint32_t nStaNum, uint32_t nUdpMaxPktCount,
-		uint32_t nUdpPktSize, bool rts, bool hidden);
+		uint32_t nUdpPktSize, bool rts, bool hidden, EvaResult *pResult = 0);
 extern void runJob();
 extern void debugJob();
-
-const bool g_bLog = true;
+extern bool sweepJob(std::string modeList, std::string staList,
+		std::string pktList, uint32_t nTotalPktCount, std::string rtsList,
+		std::string hiddenList, uint32_t nRuns, uint32_t nFirstRun,
+		uint32_t nPktSize, uint32_t nJobs, double warmup, std::string output);
+
+bool g_bLog = true;
+std::string g_vccTraceFile = "";
+bool g_bErrorTable = false;
+WarmStart g_warmStart;
 int main(int argc, char *argv[])
 {
-//	runJob();
+	bool bSweep = false;
+	std::string modeList = "vcc";
+	std::string staList = "34";
+	std::string pktList = "100";
+	uint32_t nTotalPktCount = 0;
+	std::string rtsList = "1";
+	std::string hiddenList = "1";
+	uint32_t nRuns = 1;
+	uint32_t nFirstRun = 1;
+	uint32_t nPktSize = 1500;
+	uint32_t nJobs = 0;
+	double warmup = 0.0;
+	std::string output = "";
+
+	CommandLine cmd;
+	cmd.AddValue("sweep", "run a parameter sweep instead of the debug job",
+			bSweep);
+	cmd.AddValue("mode", "comma separated list of vcc,baseline", modeList);
+	cmd.AddValue("sta", "comma separated list of station counts", staList);
+	cmd.AddValue("pkt", "comma separated list of packet counts per station",
+			pktList);
+	cmd.AddValue("totalPkt",
+			"if not 0, packet count per station is totalPkt / station count, pkt is ignored",
+			nTotalPktCount);
+	cmd.AddValue("rts", "comma separated list of RTS flags (0/1)", rtsList);
+	cmd.AddValue("hidden", "comma separated list of hidden terminal flags (0/1)",
+			hiddenList);
+	cmd.AddValue("runs", "number of replications (RngRun) of each point",
+			nRuns);
+	cmd.AddValue("firstRun", "RngRun of the first replication", nFirstRun);
+	cmd.AddValue("pktSize", "UDP packet size", nPktSize);
+	cmd.AddValue("jobs",
+			"number of simulations run in parallel, 0 for all cores", nJobs);
+	cmd.AddValue("warmup",
+			"if not 0, the replications of a point share the simulation up to this time (s) and go on from a snapshot of it, with their own RngRun and packet count",
+			warmup);
+	cmd.AddValue("output",
+			"result file, JSON if it ends with .json, CSV otherwise, stdout if empty",
+			output);
+	cmd.AddValue("vccTrace",
+			"binary trace of the ctrl channel events of the debug job, print it with vcc-trace-decode",
+			g_vccTraceFile);
+	cmd.AddValue("errorTable",
+			"interpolate the PHY error rates from tables instead of the closed form, see ns3::TableErrorRateModel",
+			g_bErrorTable);
+	cmd.Parse(argc, argv);
+
+	if (bSweep)
+	{
+		if (!sweepJob(modeList, staList, pktList, nTotalPktCount, rtsList,
+				hiddenList, nRuns, nFirstRun, nPktSize, nJobs, warmup, output))
+		{
+			return 1;
+		}
+	}
+	else
+	{
+//		runJob();
 
-	debugJob();
+		debugJob();
+	}
 
 	return 0;
 }
@@ -280,8 +381,506 @@ void runJob()
 
 }
 
+/**
+ * one point of the parameter grid, with its result
+ */
+struct SweepJob
+{
+	bool bVcc;
+	uint32_t nSta;
+	uint32_t nPkt;
+	bool bRts;
+	bool bHidden;
+	uint32_t nRun;
+
+	pid_t pid;
+	int fd; // read end of the pipe the child writes its result to
+	bool bOk;
+	EvaResult result;
+};
+
+static std::vector<std::string> SplitList(std::string list)
+{
+	std::vector<std::string> items;
+	std::istringstream iss(list);
+	std::string item;
+	while (std::getline(iss, item, ','))
+	{
+		if (!item.empty())
+		{
+			items.push_back(item);
+		}
+	}
+	return items;
+}
+
+static std::vector<uint32_t> SplitUintList(std::string list)
+{
+	std::vector<uint32_t> values;
+	std::vector<std::string> items = SplitList(list);
+	for (uint32_t i = 0; i < items.size(); ++i)
+	{
+		values.push_back(atoi(items[i].c_str()));
+	}
+	return values;
+}
+
+/**
+ * called in each branch of the snapshot of a warm start
+ */
+static void WarmStartBranch(uint32_t nBranch)
+{
+	RngSeedManager::SetRun(g_warmStart.runs[nBranch]);
+	RngSeedManager::ResetStreams();
+	// the clients of vcc() and of baseline()
+	Config::Set("/NodeList/*/ApplicationList/*/$ns3::LinUdpClient/MaxPackets",
+			UintegerValue(g_warmStart.pkts[nBranch]));
+	Config::Set("/NodeList/*/ApplicationList/*/$ns3::UdpClient/MaxPackets",
+			UintegerValue(g_warmStart.pkts[nBranch]));
+}
+
+/**
+ * called by vcc() and baseline() once the simulation is set up
+ */
+static void ScheduleWarmStart()
+{
+	if (g_warmStart.time > 0)
+	{
+		Simulator::ScheduleSnapshot(Seconds(g_warmStart.time),
+				g_warmStart.runs.size(), MakeCallback(&WarmStartBranch),
+				g_warmStart.nJobs);
+	}
+}
+
+/**
+ * run a job in a child process, its result is written back through a pipe.
+ * Every simulation gets its own copy of the global Simulator and NodeList.
+ */
+static bool StartSweepJob(SweepJob &job, uint32_t nPktSize)
+{
+	int fds[2];
+	if (pipe(fds) != 0)
+	{
+		NS_LOG_ERROR("pipe() failed");
+		return false;
+	}
+
+	pid_t pid = fork();
+	if (pid < 0)
+	{
+		NS_LOG_ERROR("fork() failed");
+		close(fds[0]);
+		close(fds[1]);
+		return false;
+	}
+
+	if (pid == 0)
+	{
+		close(fds[0]);
+		// the simulations print their figures, only the pipe matters here
+		if (freopen("/dev/null", "w", stdout) == 0)
+		{
+			_exit(1);
+		}
+		g_bLog = false;
+		g_vccTraceFile = ""; // the jobs would overwrite each other's trace
+		RngSeedManager::SetRun(job.nRun);
+
+		EvaResult result;
+		if (job.bVcc)
+		{
+			vcc(job.nSta, job.nPkt, nPktSize, job.bRts, job.bHidden, &result);
+		}
+		else
+		{
+			baseline(job.nSta, job.nPkt, nPktSize, job.bRts, job.bHidden,
+					&result);
+		}
+		ssize_t n = write(fds[1], &result, sizeof(result));
+		close(fds[1]);
+		_exit(n == sizeof(result) ? 0 : 1);
+	}
+
+	close(fds[1]);
+	job.pid = pid;
+	job.fd = fds[0];
+	return true;
+}
+
+static void PrintSweepProgress(const SweepJob &job, uint32_t nDone,
+		uint32_t nJobs)
+{
+	std::cerr << "[" << nDone << "/" << nJobs << "] "
+			<< (job.bVcc ? "vcc" : "baseline") << " sta=" << job.nSta
+			<< " pkt=" << job.nPkt << " rts=" << job.bRts << " hidden="
+			<< job.bHidden << " run=" << job.nRun << (job.bOk ? "" : " FAILED")
+			<< std::endl;
+}
+
+/**
+ * what a branch of a warm start writes back through the pipe
+ */
+struct WarmStartRecord
+{
+	uint32_t nJob;
+	EvaResult result;
+};
+
+/**
+ * run the jobs of a group, which differ only by their RngRun and packet
+ * count, as the branches of a snapshot of one simulation taken at warmup.
+ * The warm up is simulated with nWarmupRun, which none of the jobs use:
+ * a branch restarts the streams at the beginning of the substream of its
+ * own run, and would replay the draws of the warm up on the same one.
+ */
+static void RunWarmStartGroup(std::vector<SweepJob> &jobs,
+		const std::vector<uint32_t> &group, uint32_t nPktSize, double warmup,
+		uint32_t nWarmupRun, uint32_t nJobs)
+{
+	int fds[2];
+	if (pipe(fds) != 0)
+	{
+		NS_LOG_ERROR("pipe() failed");
+		return;
+	}
+
+	pid_t pid = fork();
+	if (pid < 0)
+	{
+		NS_LOG_ERROR("fork() failed");
+		close(fds[0]);
+		close(fds[1]);
+		return;
+	}
+
+	if (pid == 0)
+	{
+		close(fds[0]);
+		if (freopen("/dev/null", "w", stdout) == 0)
+		{
+			_exit(1);
+		}
+		g_bLog = false;
+		g_vccTraceFile = "";
+		const SweepJob &first = jobs[group[0]];
+		RngSeedManager::SetRun(nWarmupRun);
+		g_warmStart.time = warmup;
+		g_warmStart.nJobs = nJobs;
+		for (uint32_t i = 0; i < group.size(); ++i)
+		{
+			g_warmStart.runs.push_back(jobs[group[i]].nRun);
+			g_warmStart.pkts.push_back(jobs[group[i]].nPkt);
+		}
+
+		WarmStartRecord record;
+		if (first.bVcc)
+		{
+			vcc(first.nSta, first.nPkt, nPktSize, first.bRts, first.bHidden,
+					&record.result);
+		}
+		else
+		{
+			baseline(first.nSta, first.nPkt, nPktSize, first.bRts,
+					first.bHidden, &record.result);
+		}
+		if (g_warmStart.bParent)
+		{
+			_exit(0);
+		}
+		// no snapshot if the simulation ends before warmup
+		uint32_t nBranch = Simulator::GetBranch();
+		record.nJob = group[nBranch == Simulator::NO_BRANCH ? 0 : nBranch];
+		// smaller than PIPE_BUF: the records of the branches do not mix
+		ssize_t n = write(fds[1], &record, sizeof(record));
+		close(fds[1]);
+		_exit(n == sizeof(record) ? 0 : 1);
+	}
+
+	// read until all the branches closed the pipe, so that none of them
+	// blocks on a full pipe
+	close(fds[1]);
+	WarmStartRecord record;
+	while (read(fds[0], &record, sizeof(record)) == sizeof(record))
+	{
+		if (record.nJob < jobs.size())
+		{
+			jobs[record.nJob].result = record.result;
+			jobs[record.nJob].bOk = true;
+		}
+	}
+	close(fds[0]);
+	int status;
+	waitpid(pid, &status, 0);
+}
+
+static void FinishSweepJob(SweepJob &job, int status)
+{
+	job.bOk = false;
+	if (WIFEXITED(status) && WEXITSTATUS(status) == 0)
+	{
+		ssize_t n = read(job.fd, &job.result, sizeof(job.result));
+		job.bOk = (n == sizeof(job.result));
+	}
+	close(job.fd);
+	job.pid = 0;
+}
+
+static void WriteNumber(std::ostream &os, double value, bool bJson)
+{
+	if (std::isnan(value) || std::isinf(value))
+	{
+		os << (bJson ? "null" : "nan");
+	}
+	else
+	{
+		os << value;
+	}
+}
+
+static void WriteSweepResults(std::ostream &os,
+		const std::vector<SweepJob> &jobs, bool bJson)
+{
+	if (bJson)
+	{
+		os << "[" << std::endl;
+	}
+	else
+	{
+		os << "mode,sta,pkt,rts,hidden,run,ok,throughput,utility,"
+				<< "flows,validFlows,txPackets,rxPackets,lastRxTime,"
+				<< "rtsGrants,rtsDenies" << std::endl;
+	}
+
+	for (uint32_t i = 0; i < jobs.size(); ++i)
+	{
+		const SweepJob &job = jobs[i];
+		const char *mode = job.bVcc ? "vcc" : "baseline";
+		if (bJson)
+		{
+			os << "  {\"mode\": \"" << mode << "\", \"sta\": " << job.nSta
+					<< ", \"pkt\": " << job.nPkt << ", \"rts\": "
+					<< (job.bRts ? "true" : "false") << ", \"hidden\": "
+					<< (job.bHidden ? "true" : "false") << ", \"run\": "
+					<< job.nRun << ", \"ok\": " << (job.bOk ? "true" : "false");
+			if (job.bOk)
+			{
+				os << ", \"throughput\": ";
+				WriteNumber(os, job.result.throughput, true);
+				os << ", \"utility\": ";
+				WriteNumber(os, job.result.utility, true);
+				os << ", \"flows\": " << job.result.nFlows
+						<< ", \"validFlows\": " << job.result.nValidFlows
+						<< ", \"txPackets\": " << job.result.nTxPackets
+						<< ", \"rxPackets\": " << job.result.nRxPackets
+						<< ", \"lastRxTime\": ";
+				WriteNumber(os, job.result.lastRxTime, true);
+				os << ", \"rtsGrants\": " << job.result.nRtsGrants
+						<< ", \"rtsDenies\": " << job.result.nRtsDenies;
+			}
+			os << "}" << (i + 1 < jobs.size() ? "," : "") << std::endl;
+		}
+		else
+		{
+			os << mode << "," << job.nSta << "," << job.nPkt << ","
+					<< job.bRts << "," << job.bHidden << "," << job.nRun << ","
+					<< job.bOk;
+			if (job.bOk)
+			{
+				os << ",";
+				WriteNumber(os, job.result.throughput, false);
+				os << ",";
+				WriteNumber(os, job.result.utility, false);
+				os << "," << job.result.nFlows << ","
+						<< job.result.nValidFlows << ","
+						<< job.result.nTxPackets << ","
+						<< job.result.nRxPackets << ",";
+				WriteNumber(os, job.result.lastRxTime, false);
+				os << "," << job.result.nRtsGrants << ","
+						<< job.result.nRtsDenies;
+			}
+			else
+			{
+				os << ",,,,,,,,,";
+			}
+			os << std::endl;
+		}
+	}
+
+	if (bJson)
+	{
+		os << "]" << std::endl;
+	}
+}
+
+bool sweepJob(std::string modeList, std::string staList, std::string pktList,
+		uint32_t nTotalPktCount, std::string rtsList, std::string hiddenList,
+		uint32_t nRuns, uint32_t nFirstRun, uint32_t nPktSize, uint32_t nJobs,
+		double warmup, std::string output)
+{
+	std::vector<std::string> modes = SplitList(modeList);
+	std::vector<uint32_t> stas = SplitUintList(staList);
+	std::vector<uint32_t> pkts = SplitUintList(pktList);
+	std::vector<uint32_t> rtss = SplitUintList(rtsList);
+	std::vector<uint32_t> hiddens = SplitUintList(hiddenList);
+	// vcc() and baseline() put half of the stations on each side of the APs
+	for (uint32_t s = 0; s < stas.size(); ++s)
+	{
+		if (stas[s] < 4 || stas[s] % 2 != 0)
+		{
+			std::cerr << "--sta: station counts must be even and at least 4, not "
+					<< stas[s] << std::endl;
+			return false;
+		}
+	}
+	if (nTotalPktCount != 0)
+	{
+		pkts.assign(1, 0);
+	}
+
+	// build the parameter grid
+	std::vector<SweepJob> jobs;
+	for (uint32_t m = 0; m < modes.size(); ++m)
+	{
+		if (modes[m] != "vcc" && modes[m] != "baseline")
+		{
+			NS_FATAL_ERROR("unknown mode " << modes[m]);
+		}
+		for (uint32_t s = 0; s < stas.size(); ++s)
+		{
+			for (uint32_t p = 0; p < pkts.size(); ++p)
+			{
+				for (uint32_t r = 0; r < rtss.size(); ++r)
+				{
+					for (uint32_t h = 0; h < hiddens.size(); ++h)
+					{
+						for (uint32_t run = 0; run < nRuns; ++run)
+						{
+							SweepJob job;
+							job.bVcc = (modes[m] == "vcc");
+							job.nSta = stas[s];
+							job.nPkt =
+									nTotalPktCount != 0 ?
+											nTotalPktCount / stas[s] : pkts[p];
+							job.bRts = (rtss[r] != 0);
+							job.bHidden = (hiddens[h] != 0);
+							job.nRun = nFirstRun + run;
+							job.pid = 0;
+							job.fd = -1;
+							job.bOk = false;
+							jobs.push_back(job);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	if (nJobs == 0)
+	{
+		long nCores = sysconf(_SC_NPROCESSORS_ONLN);
+		nJobs = nCores > 0 ? nCores : 1;
+	}
+
+	uint32_t nNext = 0;
+	uint32_t nRunning = 0;
+	uint32_t nDone = 0;
+	if (warmup > 0)
+	{
+		// the jobs which differ only by RngRun and packet count share
+		// their warm up, one group after the other
+		std::vector<std::vector<uint32_t> > groups;
+		for (uint32_t i = 0; i < jobs.size(); ++i)
+		{
+			uint32_t g = 0;
+			for (; g < groups.size(); ++g)
+			{
+				const SweepJob &first = jobs[groups[g][0]];
+				if (first.bVcc == jobs[i].bVcc && first.nSta == jobs[i].nSta
+						&& first.bRts == jobs[i].bRts
+						&& first.bHidden == jobs[i].bHidden)
+				{
+					break;
+				}
+			}
+			if (g == groups.size())
+			{
+				groups.push_back(std::vector<uint32_t>());
+			}
+			groups[g].push_back(i);
+		}
+		for (uint32_t g = 0; g < groups.size(); ++g)
+		{
+			// the runs of the jobs are nFirstRun to nFirstRun + nRuns - 1
+			RunWarmStartGroup(jobs, groups[g], nPktSize, warmup,
+					nFirstRun + nRuns, nJobs);
+			for (uint32_t i = 0; i < groups[g].size(); ++i)
+			{
+				++nDone;
+				PrintSweepProgress(jobs[groups[g][i]], nDone, jobs.size());
+			}
+		}
+		nNext = jobs.size();
+	}
+
+	// keep nJobs simulations running until the grid is exhausted
+	while (nDone < jobs.size())
+	{
+		while (nRunning < nJobs && nNext < jobs.size())
+		{
+			if (StartSweepJob(jobs[nNext], nPktSize))
+			{
+				++nRunning;
+			}
+			else
+			{
+				++nDone;
+			}
+			++nNext;
+		}
+		if (nRunning == 0)
+		{
+			continue;
+		}
+
+		int status;
+		pid_t pid = waitpid(-1, &status, 0);
+		if (pid <= 0)
+		{
+			NS_FATAL_ERROR("waitpid() failed");
+		}
+		for (uint32_t i = 0; i < jobs.size(); ++i)
+		{
+			if (jobs[i].pid == pid)
+			{
+				FinishSweepJob(jobs[i], status);
+				--nRunning;
+				++nDone;
+				PrintSweepProgress(jobs[i], nDone, jobs.size());
+				break;
+			}
+		}
+	}
+
+	bool bJson = output.size() >= 5
+			&& output.compare(output.size() - 5, 5, ".json") == 0;
+	if (output.empty())
+	{
+		WriteSweepResults(std::cout, jobs, bJson);
+	}
+	else
+	{
+		std::ofstream ofs(output.c_str());
+		if (!ofs.is_open())
+		{
+			NS_FATAL_ERROR("can not open " << output);
+		}
+		WriteSweepResults(ofs, jobs, bJson);
+	}
+	return true;
+}
+
 void vcc(uint32_t nStaNum, uint32_t nUdpMaxPktCount, uint32_t nUdpPktSize,
-		bool rts, bool hidden)
+		bool rts, bool hidden, EvaResult *pResult)
 {
 
 	bool bLog = g_bLog;
@@ -302,7 +901,7 @@ void vcc(uint32_t nStaNum, uint32_t nUdpMaxPktCount, uint32_t nUdpPktSize,
 	}
 
 	uint32_t nPort = 1987;
-	bool g_bGlobalFirstRts = true;
+	Ptr<CtrlRtsArbiter> rtsArbiter = CreateObject<CtrlRtsArbiter>();
 	uint32_t nMaxCwForCtrlChn = 15;
 
 	uint32_t nMaxPktSize = nUdpPktSize;
@@ -437,6 +1036,10 @@ void vcc(uint32_t nStaNum, uint32_t nUdpMaxPktCount, uint32_t nUdpPktSize,
 
 	YansWifiPhyHelper phyHelper = YansWifiPhyHelper::Default();
 	phyHelper.SetChannel(wifiChannel);
+	if (g_bErrorTable)
+	{
+		phyHelper.SetErrorRateModel("ns3::TableErrorRateModel");
+	}
 
 	// ------------Setup Mac------------------
 	// setup STA MAC
@@ -473,6 +1076,19 @@ void vcc(uint32_t nStaNum, uint32_t nUdpMaxPktCount, uint32_t nUdpPktSize,
 	NodeContainer allNodes = staNodeContainer;
 	allNodes.Add(apNodeContainer);
 
+	// data/ctrl address registry shared by all the txops
+	Ptr<ChannelAddressRegistry> addrRegistry = CreateObject<
+			ChannelAddressRegistry>();
+	addrRegistry->Install(allNodes);
+
+	// binary trace of the ctrl channel events
+	Ptr<VccTraceRing> vccTrace;
+	if (!g_vccTraceFile.empty())
+	{
+		vccTrace = CreateObject<VccTraceRing>();
+		vccTrace->Install(allNodes);
+	}
+
 	// setup ssid/callbacks for STA, and divide them into 2 clusters
 	for (uint32_t i = 0; i < staNodeContainer.GetN(); ++i)
 	{
@@ -517,14 +1133,14 @@ void vcc(uint32_t nStaNum, uint32_t nUdpMaxPktCount, uint32_t nUdpPktSize,
 		staDataDca->SetSendByCtrlChannleCallback(
 				MakeCallback(&CtrlDcaTxop::SendByCtrlChannelImpl, staCtrlDca));
 
-		// set global information for dataDcaTxop
-		staDataDca->SetGlobalRtsSignal(&g_bGlobalFirstRts);
+		// set ctrl RTS arbiter to dataDcaTxop
+		staDataDca->SetRtsArbiter(rtsArbiter);
 
-		// set topology to dataDcaTxop
-		staDataDca->SetNodeContainer(&allNodes);
+		// set address registry to dataDcaTxop
+		staDataDca->SetAddressRegistry(addrRegistry);
 
-		// set topology to ctrlDcaTxop
-		staCtrlDca->SetNodeContainer(&allNodes);
+		// set address registry to ctrlDcaTxop
+		staCtrlDca->SetAddressRegistry(addrRegistry);
 
 		// set callback for ctrlDcaTxop
 		staCtrlDca->SetNotifyDataChannelCallback(
@@ -568,14 +1184,14 @@ void vcc(uint32_t nStaNum, uint32_t nUdpMaxPktCount, uint32_t nUdpPktSize,
 		apDataDca->SetSendByCtrlChannleCallback(
 				MakeCallback(&CtrlDcaTxop::SendByCtrlChannelImpl, apCtrlDca));
 
-		// set global information for dataDcaTxop
-		apDataDca->SetGlobalRtsSignal(&g_bGlobalFirstRts);
+		// set ctrl RTS arbiter to dataDcaTxop
+		apDataDca->SetRtsArbiter(rtsArbiter);
 
-		// set topology to dataDcaTxop
-		apDataDca->SetNodeContainer(&allNodes);
+		// set address registry to dataDcaTxop
+		apDataDca->SetAddressRegistry(addrRegistry);
 
-		// set topology to ctrlDcaTxop
-		apCtrlDca->SetNodeContainer(&allNodes);
+		// set address registry to ctrlDcaTxop
+		apCtrlDca->SetAddressRegistry(addrRegistry);
 
 		// set callback for ctrlDcaTxop
 		apCtrlDca->SetNotifyDataChannelCallback(
@@ -599,7 +1215,8 @@ void vcc(uint32_t nStaNum, uint32_t nUdpMaxPktCount, uint32_t nUdpPktSize,
 			staDataDevContainer);
 
 //	ConfigStaticArp(staNodeContainer, apNodeContainer, ipIfContainerStaData, ipIfContainerApData);
-	PopulateArpCache();
+	ArpCacheHelper arpHelper;
+	arpHelper.PopulateStatic();
 
 	// setup UDP server
 	LinUdpServerHelper srvHelper(nPort);
@@ -642,10 +1259,23 @@ void vcc(uint32_t nStaNum, uint32_t nUdpMaxPktCount, uint32_t nUdpPktSize,
 	// run
 	NS_LOG_ERROR("Simulation start" );
 	Simulator::Stop(Seconds(simulationDuration));
+	ScheduleWarmStart();
 	Simulator::Run();
+	if (Simulator::IsSnapshotParent())
+	{
+		// the branches of the warm start simulate the rest
+		g_warmStart.bParent = true;
+		Simulator::Destroy();
+		return;
+	}
 
 	NS_LOG_ERROR("Simulation end" );
 
+	if (vccTrace != 0)
+	{
+		vccTrace->Write(g_vccTraceFile);
+	}
+
 	if (bLog)
 	{
 		// print out topology information-----------------------
@@ -724,6 +1354,8 @@ void vcc(uint32_t nStaNum, uint32_t nUdpMaxPktCount, uint32_t nUdpPktSize,
 	Time lastPacketRxTime;
 	double avgThroughput = 0.0;
 	int nValidFlow = 0;
+	uint64_t nTxPackets = 0;
+	uint64_t nRxPackets = 0;
 	Ptr<Ipv4FlowClassifier> classifier = DynamicCast<Ipv4FlowClassifier>(
 			flowmon.GetClassifier());
 	std::map<FlowId, FlowMonitor::FlowStats> stats = monitor->GetFlowStats();
@@ -753,6 +1385,9 @@ void vcc(uint32_t nStaNum, uint32_t nUdpMaxPktCount, uint32_t nUdpPktSize,
 			std::cout << " Throughput: " << th << " Mbps\n";
 		}
 
+		nTxPackets += i->second.txPackets;
+		nRxPackets += i->second.rxPackets;
+
 		if (i->second.rxPackets >= VALID_FLOW_COUNT)
 		{
 			avgThroughput += th;
@@ -813,11 +1448,24 @@ void vcc(uint32_t nStaNum, uint32_t nUdpMaxPktCount, uint32_t nUdpPktSize,
 			/ lastPacketRxTime.GetDouble();
 	std::cout << " " << percentage;
 
+	if (pResult != 0)
+	{
+		pResult->throughput = avgThroughput;
+		pResult->utility = percentage;
+		pResult->nFlows = stats.size();
+		pResult->nValidFlows = nValidFlow;
+		pResult->nTxPackets = nTxPackets;
+		pResult->nRxPackets = nRxPackets;
+		pResult->lastRxTime = lastPacketRxTime.GetSeconds();
+		pResult->nRtsGrants = rtsArbiter->GetNGrants();
+		pResult->nRtsDenies = rtsArbiter->GetNDenies();
+	}
+
 	Simulator::Destroy();
 }
 
 void baseline(uint32_t nStaNum, uint32_t nUdpMaxPktCount, uint32_t nUdpPktSize,
-		bool rts, bool hidden)
+		bool rts, bool hidden, EvaResult *pResult)
 {
 
 	bool bLog = g_bLog;
@@ -967,6 +1615,10 @@ void baseline(uint32_t nStaNum, uint32_t nUdpMaxPktCount, uint32_t nUdpPktSize,
 
 	YansWifiPhyHelper phyHelper = YansWifiPhyHelper::Default();
 	phyHelper.SetChannel(wifiChannel);
+	if (g_bErrorTable)
+	{
+		phyHelper.SetErrorRateModel("ns3::TableErrorRateModel");
+	}
 
 // ------------Setup Mac------------------
 // setup STA MAC
@@ -1044,7 +1696,8 @@ void baseline(uint32_t nStaNum, uint32_t nUdpMaxPktCount, uint32_t nUdpPktSize,
 	Ipv4InterfaceContainer ipIfContainerStaData = address.Assign(
 			staDataDevContainer);
 
-	PopulateArpCache();
+	ArpCacheHelper arpHelper;
+	arpHelper.PopulateStatic();
 
 // setup UDP server
 	UdpServerHelper srvHelper(nPort);
@@ -1083,7 +1736,15 @@ void baseline(uint32_t nStaNum, uint32_t nUdpMaxPktCount, uint32_t nUdpPktSize,
 // run
 	NS_LOG_ERROR("Start simulation");
 	Simulator::Stop(Seconds(simulationDuration));
+	ScheduleWarmStart();
 	Simulator::Run();
+	if (Simulator::IsSnapshotParent())
+	{
+		// the branches of the warm start simulate the rest
+		g_warmStart.bParent = true;
+		Simulator::Destroy();
+		return;
+	}
 
 	NS_LOG_ERROR("Simulation ends");
 
@@ -1151,6 +1812,8 @@ void baseline(uint32_t nStaNum, uint32_t nUdpMaxPktCount, uint32_t nUdpPktSize,
 	Time lastPacketRxTime;
 	double avgThroughput = 0.0;
 	int nValidFlow = 0;
+	uint64_t nTxPackets = 0;
+	uint64_t nRxPackets = 0;
 	Ptr<Ipv4FlowClassifier> classifier = DynamicCast<Ipv4FlowClassifier>(
 			flowmon.GetClassifier());
 	std::map<FlowId, FlowMonitor::FlowStats> stats = monitor->GetFlowStats();
@@ -1181,6 +1844,9 @@ void baseline(uint32_t nStaNum, uint32_t nUdpMaxPktCount, uint32_t nUdpPktSize,
 
 		}
 
+		nTxPackets += i->second.txPackets;
+		nRxPackets += i->second.rxPackets;
+
 		if (i->second.rxPackets >= VALID_FLOW_COUNT)
 		{
 			avgThroughput += th;
@@ -1236,80 +1902,19 @@ void baseline(uint32_t nStaNum, uint32_t nUdpMaxPktCount, uint32_t nUdpPktSize,
 			/ lastPacketRxTime.GetDouble();
 	std::cout << " " << percentage;
 
-	Simulator::Destroy();
-
-}
-
-void PopulateArpCache()
-{
-// Creates ARP Cache object
-	Ptr<ArpCache> arp = CreateObject<ArpCache>();
-
-// Set ARP Timeout
-	arp->SetAliveTimeout(Seconds(3600 * 24 * 365)); // 1-year
-
-// Populates ARP Cache with information from all nodes
-	for (NodeList::Iterator i = NodeList::Begin(); i != NodeList::End(); ++i)
+	if (pResult != 0)
 	{
-		// Get an interactor to Ipv4L3Protocol instance
-		Ptr<Ipv4L3Protocol> ip = (*i)->GetObject<Ipv4L3Protocol>();
-		NS_ASSERT(ip !=0);
-
-		// Get interfaces list from Ipv4L3Protocol iteractor
-		ObjectVectorValue interfaces;
-		ip->GetAttribute("InterfaceList", interfaces);
-
-		// For each interface
-		for (ObjectVectorValue::Iterator j = interfaces.Begin();
-				j != interfaces.End(); j++)
-		{
-			// Get an interactor to Ipv4L3Protocol instance
-			Ptr<Ipv4Interface> ipIface =
-					(j->second)->GetObject<Ipv4Interface>();
-			NS_ASSERT(ipIface != 0);
-
-			// Get interfaces list from Ipv4L3Protocol iteractor
-			Ptr<NetDevice> device = ipIface->GetDevice();
-			NS_ASSERT(device != 0);
-
-			// Get MacAddress assigned to this device
-			Mac48Address addr = Mac48Address::ConvertFrom(device->GetAddress());
-
-			// For each Ipv4Address in the list of Ipv4Addresses assign to this interface...
-			for (uint32_t k = 0; k < ipIface->GetNAddresses(); k++)
-			{
-				// Get Ipv4Address
-				Ipv4Address ipAddr = ipIface->GetAddress(k).GetLocal();
-
-				// If Loopback address, go to the next
-				if (ipAddr == Ipv4Address::GetLoopback())
-					continue;
-
-				// Creates an ARP entry for this Ipv4Address and adds it to the ARP Cache
-				ArpCache::Entry * entry = arp->Add(ipAddr);
-				entry->MarkWaitReply(0);
-				entry->MarkAlive(addr);
-
-				NS_LOG_ERROR ("Arp Cache: Adding the pair (" << addr << "," << ipAddr << ")");
-
-			}
-		}
+		pResult->throughput = avgThroughput;
+		pResult->utility = percentage;
+		pResult->nFlows = stats.size();
+		pResult->nValidFlows = nValidFlow;
+		pResult->nTxPackets = nTxPackets;
+		pResult->nRxPackets = nRxPackets;
+		pResult->lastRxTime = lastPacketRxTime.GetSeconds();
+		pResult->nRtsGrants = 0;
+		pResult->nRtsDenies = 0;
 	}
 
-// Assign ARP Cache to each interface of each node
-	for (NodeList::Iterator i = NodeList::Begin(); i != NodeList::End(); ++i)
-	{
-		Ptr<Ipv4L3Protocol> ip = (*i)->GetObject<Ipv4L3Protocol>();
-		NS_ASSERT(ip !=0);
-		ObjectVectorValue interfaces;
-		ip->GetAttribute("InterfaceList", interfaces);
-		for (ObjectVectorValue::Iterator j = interfaces.Begin();
-				j != interfaces.End(); j++)
-		{
-			Ptr<Ipv4Interface> ipIface =
-					(j->second)->GetObject<Ipv4Interface>();
-			ipIface->SetAttribute("ArpCache", PointerValue(arp));
-		}
-	}
-}
+	Simulator::Destroy();
 
+}
@@ -48,7 +48,7 @@ int main(int argc, char *argv[])
 	}
 
 	uint32_t nPort = 1987;
-	bool g_bGlobalFirstRts = true;
+	Ptr<CtrlRtsArbiter> rtsArbiter = CreateObject<CtrlRtsArbiter>();
 
 	uint32_t nMaxPktSize = 1024;
 	Time interPktInterval = MicroSeconds(1500);
@@ -123,6 +123,11 @@ int main(int argc, char *argv[])
 	NodeContainer allNodes = staNodeContainer;
 	allNodes.Add(apNodeContainer);
 
+	// data/ctrl address registry shared by all the txops
+	Ptr<ChannelAddressRegistry> addrRegistry = CreateObject<
+			ChannelAddressRegistry>();
+	addrRegistry->Install(allNodes);
+
 	// setup ssid/callbacks for STA, and divide them into 2 clusters
 	NodeContainer staWithAp0;
 	NodeContainer staWithAp1;
@@ -168,14 +173,14 @@ int main(int argc, char *argv[])
 		staDataDca->SetSendByCtrlChannleCallback(
 				MakeCallback(&CtrlDcaTxop::SendByCtrlChannelImpl, staCtrlDca));
 
-		// set global information for dataDcaTxop
-		staDataDca->SetGlobalRtsSignal(&g_bGlobalFirstRts);
+		// set ctrl RTS arbiter to dataDcaTxop
+		staDataDca->SetRtsArbiter(rtsArbiter);
 
-		// set topology to dataDcaTxop
-		staDataDca->SetNodeContainer(&allNodes);
+		// set address registry to dataDcaTxop
+		staDataDca->SetAddressRegistry(addrRegistry);
 
-		// set topology to ctrlDcaTxop
-		staCtrlDca->SetNodeContainer(&allNodes);
+		// set address registry to ctrlDcaTxop
+		staCtrlDca->SetAddressRegistry(addrRegistry);
 
 		// set callback for ctrlDcaTxop
 		staCtrlDca->SetNotifyDataChannelCallback(
@@ -213,14 +218,14 @@ int main(int argc, char *argv[])
 		apDataDca->SetSendByCtrlChannleCallback(
 				MakeCallback(&CtrlDcaTxop::SendByCtrlChannelImpl, apCtrlDca));
 
-		// set global information for dataDcaTxop
-		apDataDca->SetGlobalRtsSignal(&g_bGlobalFirstRts);
+		// set ctrl RTS arbiter to dataDcaTxop
+		apDataDca->SetRtsArbiter(rtsArbiter);
 
-		// set topology to dataDcaTxop
-		apDataDca->SetNodeContainer(&allNodes);
+		// set address registry to dataDcaTxop
+		apDataDca->SetAddressRegistry(addrRegistry);
 
-		// set topology to ctrlDcaTxop
-		apCtrlDca->SetNodeContainer(&allNodes);
+		// set address registry to ctrlDcaTxop
+		apCtrlDca->SetAddressRegistry(addrRegistry);
 
 		// set callback for ctrlDcaTxop
 		apCtrlDca->SetNotifyDataChannelCallback(
@@ -25,10 +25,25 @@
 
 #include "ptr.h"
 #include "pointer.h"
+#include "string.h"
 #include "assert.h"
 #include "log.h"
+#include "ns3/core-config.h"
 
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <typeinfo>
+#include <time.h>
+#ifdef __GNUC__
+#include <cxxabi.h>
+#endif
+#if defined (HAVE_DLFCN_H) && defined (HAVE_DL)
+#include <dlfcn.h>
+#endif
 
 // Note:  Logging in this file is largely avoided due to the
 // number of calls that are made to these functions and the possibility
@@ -40,12 +55,48 @@ namespace ns3 {
 
 NS_OBJECT_ENSURE_REGISTERED (DefaultSimulatorImpl);
 
+/* the number of cells of the inbox, a power of two */
+static const uint32_t INBOX_SIZE = 1024;
+/* the number of events between two samples of the depth of the queue
+ * when profiling */
+static const uint64_t PROFILE_DEPTH_PERIOD = 1024;
+
+static inline uint32_t
+AtomicLoad (volatile uint32_t *p)
+{
+#ifdef __ATOMIC_ACQUIRE
+  return __atomic_load_n (p, __ATOMIC_ACQUIRE);
+#else
+  uint32_t v = *p;
+  __sync_synchronize ();
+  return v;
+#endif
+}
+
+static inline void
+AtomicStore (volatile uint32_t *p, uint32_t v)
+{
+#ifdef __ATOMIC_RELEASE
+  __atomic_store_n (p, v, __ATOMIC_RELEASE);
+#else
+  __sync_synchronize ();
+  *p = v;
+#endif
+}
+
 TypeId
 DefaultSimulatorImpl::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::DefaultSimulatorImpl")
     .SetParent<SimulatorImpl> ()
     .AddConstructor<DefaultSimulatorImpl> ()
+    .AddAttribute ("ProfileFile",
+                   "The file to write the profile of the events to at Simulator::Destroy, "
+                   "see DefaultSimulatorImpl. Empty to disable profiling.",
+                   StringValue (""),
+                   MakeStringAccessor (&DefaultSimulatorImpl::SetProfileFile,
+                                       &DefaultSimulatorImpl::GetProfileFile),
+                   MakeStringChecker ())
   ;
   return tid;
 }
@@ -65,12 +116,24 @@ DefaultSimulatorImpl::DefaultSimulatorImpl ()
   m_currentContext = 0xffffffff;
   m_unscheduledEvents = 0;
   m_eventsWithContextEmpty = true;
+  m_inbox = new InboxCell [INBOX_SIZE];
+  for (uint32_t i = 0; i < INBOX_SIZE; i++)
+    {
+      m_inbox[i].sequence = i;
+    }
+  m_inboxTail = 0;
+  m_inboxHead = 0;
   m_main = SystemThread::Self();
+  EventImpl::SetPoolThread ();
+  m_profile = false;
+  m_profileMaxDepth = 0;
+  m_profileEvents = 0;
 }
 
 DefaultSimulatorImpl::~DefaultSimulatorImpl ()
 {
   NS_LOG_FUNCTION (this);
+  delete [] m_inbox;
 }
 
 void
@@ -89,6 +152,10 @@ void
 DefaultSimulatorImpl::Destroy ()
 {
   NS_LOG_FUNCTION (this);
+  if (m_profile)
+    {
+      WriteProfile ();
+    }
   while (!m_destroyEvents.empty ()) 
     {
       Ptr<EventImpl> ev = m_destroyEvents.front ().PeekEventImpl ();
@@ -137,7 +204,14 @@ DefaultSimulatorImpl::ProcessOneEvent (void)
   m_currentTs = next.key.m_ts;
   m_currentContext = next.key.m_context;
   m_currentUid = next.key.m_uid;
-  next.impl->Invoke ();
+  if (m_profile)
+    {
+      ProfileEvent (next);
+    }
+  else
+    {
+      next.impl->Invoke ();
+    }
   next.impl->Unref ();
 
   ProcessEventsWithContext ();
@@ -149,10 +223,69 @@ DefaultSimulatorImpl::IsFinished (void) const
   return m_events->IsEmpty () || m_stop;
 }
 
+bool
+DefaultSimulatorImpl::PushInbox (const struct EventWithContext &event)
+{
+  uint32_t pos = AtomicLoad (&m_inboxTail);
+  while (true)
+    {
+      InboxCell *cell = &m_inbox[pos & (INBOX_SIZE - 1)];
+      int32_t diff = (int32_t)(AtomicLoad (&cell->sequence) - pos);
+      if (diff == 0)
+        {
+          if (__sync_bool_compare_and_swap (&m_inboxTail, pos, pos + 1))
+            {
+              cell->event = event;
+              AtomicStore (&cell->sequence, pos + 1);
+              return true;
+            }
+        }
+      else if (diff < 0)
+        {
+          // the main thread has not read this cell yet: the inbox is full
+          return false;
+        }
+      // another thread took this position
+      pos = AtomicLoad (&m_inboxTail);
+    }
+}
+
+void
+DefaultSimulatorImpl::InsertEventWithContext (const struct EventWithContext &event)
+{
+  Scheduler::Event ev;
+  ev.impl = event.event;
+  ev.key.m_ts = m_currentTs + event.timestamp;
+  ev.key.m_context = event.context;
+  ev.key.m_uid = m_uid;
+  m_uid++;
+  m_unscheduledEvents++;
+  m_events->Insert (ev);
+  if (m_profile)
+    {
+      ev.impl->SetScheduleTs (m_currentTs);
+    }
+}
+
 void
 DefaultSimulatorImpl::ProcessEventsWithContext (void)
 {
-  if (m_eventsWithContextEmpty)
+  InboxCell *cell = &m_inbox[m_inboxHead & (INBOX_SIZE - 1)];
+  if (AtomicLoad (&cell->sequence) != m_inboxHead + 1 && m_eventsWithContextEmpty)
+    {
+      return;
+    }
+
+  while (AtomicLoad (&cell->sequence) == m_inboxHead + 1)
+    {
+      InsertEventWithContext (cell->event);
+      AtomicStore (&cell->sequence, m_inboxHead + INBOX_SIZE);
+      m_inboxHead++;
+      cell = &m_inbox[m_inboxHead & (INBOX_SIZE - 1)];
+    }
+  // the events which did not fit come after the ones of the same thread
+  // in the inbox: wait for the threads which are writing a cell
+  if (m_eventsWithContextEmpty || m_inboxHead != AtomicLoad (&m_inboxTail))
     {
       return;
     }
@@ -166,16 +299,8 @@ DefaultSimulatorImpl::ProcessEventsWithContext (void)
   }
   while (!eventsWithContext.empty ())
     {
-       EventWithContext event = eventsWithContext.front ();
+       InsertEventWithContext (eventsWithContext.front ());
        eventsWithContext.pop_front ();
-       Scheduler::Event ev;
-       ev.impl = event.event;
-       ev.key.m_ts = m_currentTs + event.timestamp;
-       ev.key.m_context = event.context;
-       ev.key.m_uid = m_uid;
-       m_uid++;
-       m_unscheduledEvents++;
-       m_events->Insert (ev);
     }
 }
 
@@ -185,6 +310,7 @@ DefaultSimulatorImpl::Run (void)
   NS_LOG_FUNCTION (this);
   // Set the current threadId as the main threadId
   m_main = SystemThread::Self();
+  EventImpl::SetPoolThread ();
   ProcessEventsWithContext ();
   m_stop = false;
 
@@ -233,6 +359,10 @@ DefaultSimulatorImpl::Schedule (Time const &time, EventImpl *event)
   m_uid++;
   m_unscheduledEvents++;
   m_events->Insert (ev);
+  if (m_profile)
+    {
+      ev.impl->SetScheduleTs (m_currentTs);
+    }
   return EventId (event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
 }
 
@@ -252,6 +382,10 @@ DefaultSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &time, E
       m_uid++;
       m_unscheduledEvents++;
       m_events->Insert (ev);
+      if (m_profile)
+        {
+          ev.impl->SetScheduleTs (m_currentTs);
+        }
     }
   else
     {
@@ -259,6 +393,12 @@ DefaultSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &time, E
       ev.context = context;
       ev.timestamp = time.GetTimeStep ();
       ev.event = event;
+      // once an event did not fit, the next ones follow it until the
+      // main thread has read it
+      if (m_eventsWithContextEmpty && PushInbox (ev))
+        {
+          return;
+        }
       {
         CriticalSection cs (m_eventsWithContextMutex);
         m_eventsWithContext.push_back(ev);
@@ -280,6 +420,10 @@ DefaultSimulatorImpl::ScheduleNow (EventImpl *event)
   m_uid++;
   m_unscheduledEvents++;
   m_events->Insert (ev);
+  if (m_profile)
+    {
+      ev.impl->SetScheduleTs (m_currentTs);
+    }
   return EventId (event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
 }
 
@@ -404,4 +548,178 @@ DefaultSimulatorImpl::GetContext (void) const
   return m_currentContext;
 }
 
+void
+DefaultSimulatorImpl::SetProfileFile (std::string filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  m_profileFile = filename;
+  m_profile = !filename.empty ();
+}
+
+std::string
+DefaultSimulatorImpl::GetProfileFile (void) const
+{
+  return m_profileFile;
+}
+
+static std::string
+Demangle (const char *name)
+{
+#ifdef __GNUC__
+  int status;
+  char *demangled = abi::__cxa_demangle (name, 0, 0, &status);
+  if (status == 0)
+    {
+      std::string result = demangled;
+      std::free (demangled);
+      return result;
+    }
+#endif
+  return name;
+}
+
+bool
+DefaultSimulatorImpl::ProfileKey::operator < (const ProfileKey &o) const
+{
+  if (*type != *o.type)
+    {
+      return type->before (*o.type);
+    }
+  return std::memcmp (function.word, o.function.word, sizeof (function.word)) < 0;
+}
+
+/* the name of the function called by the events if its symbol can be
+ * found, or the name of the type of the events */
+static std::string
+GetEventName (const std::type_info &type, const struct EventImpl::Function &function)
+{
+  // the first word of a pointer to a function, and of a pointer to a
+  // method which is not virtual in the Itanium C++ ABI, is the address
+  // of its code
+  void *address = reinterpret_cast<void *> (function.word[0]);
+#if defined (HAVE_DLFCN_H) && defined (HAVE_DL)
+  Dl_info info;
+  if (address != 0 && dladdr (address, &info) != 0
+      && info.dli_sname != 0 && info.dli_saddr == address)
+    {
+      return Demangle (info.dli_sname);
+    }
+#endif
+  std::ostringstream oss;
+  oss << Demangle (type.name ());
+  if (address != 0)
+    {
+      oss << " " << address;
+    }
+  return oss.str ();
+}
+
+void
+DefaultSimulatorImpl::ProfileEvent (const Scheduler::Event &next)
+{
+  ProfileKey key;
+  key.type = &typeid (*next.impl);
+  key.function = next.impl->GetFunction ();
+  ProfileEntries::iterator i = m_profileEntries.find (key);
+  if (i == m_profileEntries.end ())
+    {
+      ProfileEntry entry;
+      entry.count = 0;
+      entry.cancelled = 0;
+      entry.wallTime = 0.0;
+      entry.delay = 0;
+      entry.delayCount = 0;
+      i = m_profileEntries.insert (std::make_pair (key, entry)).first;
+    }
+  // the entries are not moved by the insertions of the event
+  ProfileEntry &entry = i->second;
+  entry.count++;
+  if (next.impl->IsCancelled ())
+    {
+      entry.cancelled++;
+    }
+  uint64_t scheduled;
+  if (next.impl->GetScheduleTs (scheduled))
+    {
+      entry.delay += next.key.m_ts - scheduled;
+      entry.delayCount++;
+    }
+  // the event itself is already out of the queue
+  m_profileMaxDepth = std::max (m_profileMaxDepth, m_unscheduledEvents + 1);
+  if (m_profileEvents % PROFILE_DEPTH_PERIOD == 0)
+    {
+      m_profileDepth.push_back (std::make_pair (next.key.m_ts, m_unscheduledEvents + 1));
+    }
+  m_profileEvents++;
+
+  // most events last less than a microsecond
+  struct timespec start;
+  struct timespec end;
+  clock_gettime (CLOCK_MONOTONIC, &start);
+  next.impl->Invoke ();
+  clock_gettime (CLOCK_MONOTONIC, &end);
+  entry.wallTime += (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) * 1e-9;
+}
+
+template <typename T>
+static bool
+IsSlower (const std::pair<double, T> &a, const std::pair<double, T> &b)
+{
+  return a.first > b.first;
+}
+
+void
+DefaultSimulatorImpl::WriteProfile (void)
+{
+  NS_LOG_FUNCTION (this);
+  typedef std::vector<std::pair<double, ProfileEntries::const_iterator> > Order;
+  Order order;
+  double wallTime = 0.0;
+  for (ProfileEntries::const_iterator i = m_profileEntries.begin (); i != m_profileEntries.end (); ++i)
+    {
+      order.push_back (std::make_pair (i->second.wallTime, i));
+      wallTime += i->second.wallTime;
+    }
+  std::stable_sort (order.begin (), order.end (), &IsSlower<ProfileEntries::const_iterator>);
+
+  std::ofstream os (m_profileFile.c_str ());
+  std::string folded = m_profileFile + ".folded";
+  std::ofstream osFolded (folded.c_str ());
+  if (!os.is_open () || !osFolded.is_open ())
+    {
+      NS_LOG_WARN ("cannot write the profile to " << m_profileFile);
+      return;
+    }
+  os << "# " << m_profileEvents << " events, " << wallTime << " s of wall clock time, "
+     << m_profileMaxDepth << " events in queue at most" << std::endl;
+  os << "# wall(s) wall(%) events cancelled wall/event(us) delay(s) function" << std::endl;
+  for (Order::const_iterator i = order.begin (); i != order.end (); ++i)
+    {
+      const ProfileKey &key = i->second->first;
+      const ProfileEntry &entry = i->second->second;
+      std::string name = GetEventName (*key.type, key.function);
+      double delay = entry.delayCount == 0 ? 0.0 :
+        TimeStep (entry.delay).GetSeconds () / entry.delayCount;
+      os << entry.wallTime << " "
+         << (wallTime > 0.0 ? 100.0 * entry.wallTime / wallTime : 0.0) << " "
+         << entry.count << " " << entry.cancelled << " "
+         << 1e6 * entry.wallTime / entry.count << " "
+         << delay << " " << name << std::endl;
+      // a frame of a stack for flamegraph.pl, with the wall clock time in us
+      uint64_t us = (uint64_t)(entry.wallTime * 1e6 + 0.5);
+      if (us > 0)
+        {
+          std::string frame = name;
+          std::replace (frame.begin (), frame.end (), ';', ',');
+          osFolded << "ns3::Simulator::Run;" << frame << " " << us << std::endl;
+        }
+    }
+  os << "# time(s) events in queue" << std::endl;
+  for (std::vector<std::pair<uint64_t, int> >::const_iterator i = m_profileDepth.begin ();
+       i != m_profileDepth.end (); ++i)
+    {
+      os << TimeStep (i->first).GetSeconds () << " " << i->second << std::endl;
+    }
+}
+
 } // namespace ns3
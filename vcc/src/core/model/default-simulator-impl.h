@@ -30,9 +30,27 @@
 #include "ptr.h"
 
 #include <list>
+#include <map>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
 
 namespace ns3 {
 
+/**
+ * \ingroup core
+ *
+ * When the attribute ProfileFile is set, the events are profiled: for
+ * each function called by the events, the number of events, the wall
+ * clock time spent in them and the mean delay between their scheduling
+ * and their execution are written, sorted by wall clock time, to that
+ * file at Simulator::Destroy, followed by samples of the number of
+ * events in queue over the simulation time. The wall clock times are
+ * also written in the folded format of flamegraph.pl to the same file
+ * with the suffix ".folded". The functions are named after their symbol
+ * when it can be found, and after the type of the events otherwise.
+ */
 class DefaultSimulatorImpl : public SimulatorImpl
 {
 public:
@@ -70,9 +88,57 @@ private:
     uint64_t timestamp;
     EventImpl *event;
   };
+  /* a cell of the inbox of the events scheduled by the other threads:
+   * it is free for the thread which got the position <i>sequence</i>,
+   * and holds an event for the main thread at position sequence - 1 */
+  struct InboxCell {
+    volatile uint32_t sequence;
+    struct EventWithContext event;
+  };
+  bool PushInbox (const struct EventWithContext &event);
+  void InsertEventWithContext (const struct EventWithContext &event);
+
+  /* the type of the events and the function they call */
+  struct ProfileKey {
+    const std::type_info *type;
+    struct EventImpl::Function function;
+    bool operator < (const ProfileKey &o) const;
+  };
+  /* the statistics of the events which call the same function */
+  struct ProfileEntry {
+    uint64_t count;
+    uint64_t cancelled;
+    // in seconds
+    double wallTime;
+    // sum of the time steps from the scheduling of the events to their
+    // execution, over the delayCount events scheduled while profiling
+    uint64_t delay;
+    uint64_t delayCount;
+  };
+  typedef std::map<ProfileKey, ProfileEntry> ProfileEntries;
+  void SetProfileFile (std::string filename);
+  std::string GetProfileFile (void) const;
+  void ProfileEvent (const Scheduler::Event &next);
+  void WriteProfile (void);
+
+  std::string m_profileFile;
+  bool m_profile;
+  // by type of event and function
+  ProfileEntries m_profileEntries;
+  // samples of the time and of the number of events in queue
+  std::vector<std::pair<uint64_t, int> > m_profileDepth;
+  int m_profileMaxDepth;
+  uint64_t m_profileEvents;
+
+  InboxCell *m_inbox;
+  // next position of the other threads
+  volatile uint32_t m_inboxTail;
+  // next position of the main thread
+  uint32_t m_inboxHead;
+  // the events which did not fit in the inbox
   typedef std::list<struct EventWithContext> EventsWithContext;
   EventsWithContext m_eventsWithContext;
-  bool m_eventsWithContextEmpty;
+  volatile bool m_eventsWithContextEmpty;
   SystemMutex m_eventsWithContextMutex;
 
   typedef std::list<EventId> DestroyEvents;
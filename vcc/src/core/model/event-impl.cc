@@ -19,19 +19,111 @@
  */
 
 #include "event-impl.h"
+#include "system-thread.h"
 #include "log.h"
+#include <new>
 
 NS_LOG_COMPONENT_DEFINE ("EventImpl");
 
 namespace ns3 {
 
+/* the free lists are indexed by the size of their blocks divided by
+ * POOL_ALIGN, and keep up to POOL_MAX blocks each */
+static const std::size_t POOL_ALIGN = 16;
+static const std::size_t POOL_LISTS = 256 / POOL_ALIGN + 1;
+static const uint32_t POOL_MAX = 4096;
+
+struct PoolBlock
+{
+  PoolBlock *next;
+};
+
+/* plain data, so that they are usable before the static constructors run */
+static PoolBlock *g_poolLists[POOL_LISTS];
+static uint32_t g_poolSizes[POOL_LISTS];
+static SystemThread::ThreadId g_poolThread;
+static bool g_poolThreadSet = false;
+static bool g_poolDestroyed = false;
+
+static struct PoolDestructor
+{
+  ~PoolDestructor ()
+  {
+    g_poolDestroyed = true;
+    g_poolThreadSet = false;
+    for (std::size_t i = 0; i < POOL_LISTS; i++)
+      {
+        while (g_poolLists[i] != 0)
+          {
+            PoolBlock *block = g_poolLists[i];
+            g_poolLists[i] = block->next;
+            ::operator delete (block);
+          }
+        g_poolSizes[i] = 0;
+      }
+  }
+} g_poolDestructor;
+
+static inline bool
+IsPoolThread (void)
+{
+  return g_poolThreadSet && SystemThread::Equals (g_poolThread);
+}
+
+void *
+EventImpl::operator new (std::size_t size)
+{
+  std::size_t list = (size + POOL_ALIGN - 1) / POOL_ALIGN;
+  if (list >= POOL_LISTS)
+    {
+      return ::operator new (size);
+    }
+  if (g_poolLists[list] != 0 && IsPoolThread ())
+    {
+      PoolBlock *block = g_poolLists[list];
+      g_poolLists[list] = block->next;
+      g_poolSizes[list]--;
+      return block;
+    }
+  // all the blocks of a list have the same size, wherever they come from
+  return ::operator new (list * POOL_ALIGN);
+}
+
+void
+EventImpl::operator delete (void *p, std::size_t size)
+{
+  std::size_t list = (size + POOL_ALIGN - 1) / POOL_ALIGN;
+  if (list < POOL_LISTS && g_poolSizes[list] < POOL_MAX && IsPoolThread ())
+    {
+      PoolBlock *block = static_cast<PoolBlock *> (p);
+      block->next = g_poolLists[list];
+      g_poolLists[list] = block;
+      g_poolSizes[list]++;
+      return;
+    }
+  ::operator delete (p);
+}
+
+void
+EventImpl::SetPoolThread (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  if (!g_poolDestroyed)
+    {
+      g_poolThread = SystemThread::Self ();
+      g_poolThreadSet = true;
+    }
+}
+
 EventImpl::~EventImpl ()
 {
   NS_LOG_FUNCTION (this);
 }
 
 EventImpl::EventImpl ()
-  : m_cancel (false)
+  : m_cancel (false),
+    m_hasScheduleTs (false),
+    m_scheduleTs (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -60,4 +152,12 @@ EventImpl::IsCancelled (void)
   return m_cancel;
 }
 
+struct EventImpl::Function
+EventImpl::GetFunction (void) const
+{
+  NS_LOG_FUNCTION (this);
+  struct Function bytes = { { 0, 0 } };
+  return bytes;
+}
+
 } // namespace ns3
@@ -21,6 +21,8 @@
 #define EVENT_IMPL_H
 
 #include <stdint.h>
+#include <cstddef>
+#include <cstring>
 #include "simple-ref-count.h"
 
 namespace ns3 {
@@ -35,6 +37,13 @@ namespace ns3 {
  * obviously (there are Ref and Unref methods) reference-counted and
  * most subclasses are usually created by one of the many Simulator::Schedule
  * methods.
+ *
+ * The events, with the arguments bound by MakeEvent which they hold, are
+ * allocated from free lists of blocks of a multiple of 16 bytes, up to
+ * 256 bytes, which keep the blocks of the deleted events for the next
+ * ones. Only the main thread of the simulator uses them: the events
+ * created or deleted by the other threads, and the larger ones, go to the
+ * global allocator.
  */
 class EventImpl : public SimpleRefCount<EventImpl>
 {
@@ -57,14 +66,85 @@ public:
    * Invoked by the simulation engine before calling Invoke.
    */
   bool IsCancelled (void);
+  /**
+   * The bytes of a pointer to a function or to a method, zero padded.
+   * Two words hold a pointer to a method in the Itanium C++ ABI.
+   */
+  struct Function
+  {
+    uintptr_t word[2];
+  };
+  /**
+   * \returns the bytes of the pointer to the function or to the method
+   *          which Notify calls, or zeros if they are unknown.
+   *
+   * Used by the profiler of DefaultSimulatorImpl to tell apart the events
+   * of the same type which call different functions.
+   */
+  virtual struct Function GetFunction (void) const;
+  /**
+   * \param ts the time step at which the event is scheduled
+   *
+   * Recorded by the profiler of DefaultSimulatorImpl, which measures the
+   * delay from the scheduling of an event to its execution.
+   */
+  void SetScheduleTs (uint64_t ts);
+  /**
+   * \param ts the time step given to SetScheduleTs
+   * \returns false if SetScheduleTs was not called
+   */
+  bool GetScheduleTs (uint64_t &ts) const;
+
+  /**
+   * \param size the size of the subclass to allocate
+   * \returns a block of at least size bytes, from the free lists if possible
+   */
+  static void * operator new (std::size_t size);
+  /**
+   * \param p a block returned by operator new
+   * \param size the size of the subclass which is deleted
+   */
+  static void operator delete (void *p, std::size_t size);
+  /**
+   * Make the calling thread the only one to use the free lists. Called
+   * by the simulators from the thread which runs the events.
+   */
+  static void SetPoolThread (void);
 
 protected:
   virtual void Notify (void) = 0;
+  /**
+   * \param function a pointer to a function or to a method
+   * \returns the bytes of the pointer, for GetFunction
+   */
+  template <typename F>
+  static struct Function GetBytes (const F &function)
+  {
+    struct Function bytes = { { 0, 0 } };
+    std::memcpy (bytes.word, &function, sizeof (F) < sizeof (bytes.word) ? sizeof (F) : sizeof (bytes.word));
+    return bytes;
+  }
 
 private:
   bool m_cancel;
+  bool m_hasScheduleTs;
+  uint64_t m_scheduleTs;
 };
 
+inline void
+EventImpl::SetScheduleTs (uint64_t ts)
+{
+  m_scheduleTs = ts;
+  m_hasScheduleTs = true;
+}
+
+inline bool
+EventImpl::GetScheduleTs (uint64_t &ts) const
+{
+  ts = m_scheduleTs;
+  return m_hasScheduleTs;
+}
+
 } // namespace ns3
 
 #endif /* EVENT_IMPL_H */
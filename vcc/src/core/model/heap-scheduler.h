@@ -74,7 +74,7 @@ private:
   inline uint32_t Smallest (uint32_t a, uint32_t b) const;
 
   inline void Exch (uint32_t a, uint32_t b);
-  void BottomUp (void);
+  void BottomUp (uint32_t start);
   void TopDown (uint32_t start);
 
   BinaryHeap m_heap;
@@ -0,0 +1,312 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ladder-scheduler.h"
+#include "event-impl.h"
+#include <algorithm>
+#include "assert.h"
+#include "log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LadderScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (LadderScheduler);
+
+/* the largest bucket which is sorted into Bottom instead of being spread
+ * into a new rung */
+static const uint32_t THRESHOLD = 50;
+/* the largest number of rungs */
+static const uint32_t MAX_RUNGS = 8;
+
+/* the order of Bottom: the earliest event at the back */
+static bool
+IsLater (const Scheduler::Event &a, const Scheduler::Event &b)
+{
+  return b.key < a.key;
+}
+
+TypeId
+LadderScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::LadderScheduler")
+    .SetParent<Scheduler> ()
+    .AddConstructor<LadderScheduler> ()
+  ;
+  return tid;
+}
+
+LadderScheduler::LadderScheduler ()
+  : m_topMin (0),
+    m_topMax (0),
+    m_topStart (0),
+    m_nRungs (0),
+    m_size (0)
+{
+  NS_LOG_FUNCTION (this);
+  m_rungs.reserve (MAX_RUNGS);
+}
+LadderScheduler::~LadderScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+uint64_t
+LadderScheduler::GetCurrentStart (const Rung &rung)
+{
+  return rung.start + rung.current * rung.width;
+}
+
+void
+LadderScheduler::Insert (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.key.m_ts << ev.key.m_uid);
+  uint64_t ts = ev.key.m_ts;
+  m_size++;
+  if (ts >= m_topStart)
+    {
+      if (m_top.empty ())
+        {
+          m_topMin = ts;
+          m_topMax = ts;
+        }
+      m_topMin = std::min (m_topMin, ts);
+      m_topMax = std::max (m_topMax, ts);
+      m_top.push_back (ev);
+      return;
+    }
+  for (uint32_t i = 0; i < m_nRungs; i++)
+    {
+      Rung &rung = m_rungs[i];
+      if (ts >= GetCurrentStart (rung))
+        {
+          uint64_t bucket = (ts - rung.start) / rung.width;
+          NS_ASSERT (bucket < rung.nBuckets);
+          rung.buckets[bucket].push_back (ev);
+          rung.size++;
+          return;
+        }
+    }
+  InsertInBottom (ev);
+}
+
+void
+LadderScheduler::InsertInBottom (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.key.m_ts << ev.key.m_uid);
+  Bucket::iterator i = std::lower_bound (m_bottom.begin (), m_bottom.end (), ev, &IsLater);
+  m_bottom.insert (i, ev);
+  if (m_bottom.size () <= THRESHOLD || m_nRungs == MAX_RUNGS)
+    {
+      return;
+    }
+  // too many events were inserted in the range of Bottom: spread them
+  // into a new rung which ends where the lowest rung, or Top, starts
+  uint64_t start = m_bottom.back ().key.m_ts;
+  uint64_t end = m_nRungs == 0 ? m_topStart : GetCurrentStart (m_rungs[m_nRungs - 1]);
+  NS_ASSERT (end > m_bottom.front ().key.m_ts);
+  uint64_t width = (end - start) / m_bottom.size () + 1;
+  uint32_t nBuckets = (end - start) / width + 1;
+  InitRung (start, width, nBuckets);
+  Rung &rung = m_rungs[m_nRungs - 1];
+  for (Bucket::const_iterator j = m_bottom.begin (); j != m_bottom.end (); ++j)
+    {
+      rung.buckets[(j->key.m_ts - start) / width].push_back (*j);
+    }
+  rung.size = m_bottom.size ();
+  m_bottom.clear ();
+  NS_LOG_LOGIC ("rung " << m_nRungs - 1 << " from bottom, width=" << width << ", nBuckets=" << nBuckets);
+}
+
+bool
+LadderScheduler::IsEmpty (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_size == 0;
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  if (m_bottom.empty ())
+    {
+      // the events are only moved down the ladder: the order is unchanged
+      const_cast<LadderScheduler *> (this)->Refill ();
+    }
+  return m_bottom.back ();
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  if (m_bottom.empty ())
+    {
+      Refill ();
+    }
+  Scheduler::Event ev = m_bottom.back ();
+  m_bottom.pop_back ();
+  m_size--;
+  NS_LOG_LOGIC ("remove ts=" << ev.key.m_ts << ", key=" << ev.key.m_uid);
+  return ev;
+}
+
+bool
+LadderScheduler::Remove (Bucket *bucket, const Event &ev)
+{
+  for (Bucket::iterator i = bucket->begin (); i != bucket->end (); ++i)
+    {
+      if (i->key.m_uid == ev.key.m_uid)
+        {
+          NS_ASSERT (ev.impl == i->impl);
+          // the buckets are not sorted
+          *i = bucket->back ();
+          bucket->pop_back ();
+          return true;
+        }
+    }
+  return false;
+}
+
+void
+LadderScheduler::Remove (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.key.m_ts << ev.key.m_uid);
+  NS_ASSERT (!IsEmpty ());
+  uint64_t ts = ev.key.m_ts;
+  m_size--;
+  if (ts >= m_topStart)
+    {
+      bool found = Remove (&m_top, ev);
+      NS_ASSERT (found);
+      return;
+    }
+  for (uint32_t i = 0; i < m_nRungs; i++)
+    {
+      Rung &rung = m_rungs[i];
+      if (ts >= GetCurrentStart (rung))
+        {
+          bool found = Remove (&rung.buckets[(ts - rung.start) / rung.width], ev);
+          NS_ASSERT (found);
+          rung.size--;
+          return;
+        }
+    }
+  Bucket::iterator i = std::lower_bound (m_bottom.begin (), m_bottom.end (), ev, &IsLater);
+  NS_ASSERT (i != m_bottom.end () && i->key.m_uid == ev.key.m_uid);
+  m_bottom.erase (i);
+}
+
+void
+LadderScheduler::InitRung (uint64_t start, uint64_t width, uint32_t nBuckets)
+{
+  NS_LOG_FUNCTION (this << start << width << nBuckets);
+  if (m_nRungs == m_rungs.size ())
+    {
+      m_rungs.push_back (Rung ());
+    }
+  Rung &rung = m_rungs[m_nRungs];
+  m_nRungs++;
+  rung.start = start;
+  rung.width = width;
+  rung.current = 0;
+  rung.nBuckets = nBuckets;
+  rung.size = 0;
+  // all the buckets left by the previous users of this rung are empty
+  if (rung.buckets.size () < nBuckets)
+    {
+      rung.buckets.resize (nBuckets);
+    }
+}
+
+void
+LadderScheduler::Refill (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (m_bottom.empty () && !IsEmpty ());
+  while (true)
+    {
+      if (m_nRungs == 0)
+        {
+          NS_ASSERT (!m_top.empty ());
+          if (m_top.size () <= THRESHOLD)
+            {
+              m_bottom.swap (m_top);
+              std::sort (m_bottom.begin (), m_bottom.end (), &IsLater);
+              m_topStart = m_topMax + 1;
+              return;
+            }
+          uint64_t width = (m_topMax - m_topMin) / m_top.size () + 1;
+          uint32_t nBuckets = (m_topMax - m_topMin) / width + 1;
+          InitRung (m_topMin, width, nBuckets);
+          Rung &rung = m_rungs[0];
+          for (Bucket::const_iterator i = m_top.begin (); i != m_top.end (); ++i)
+            {
+              rung.buckets[(i->key.m_ts - rung.start) / width].push_back (*i);
+            }
+          rung.size = m_top.size ();
+          m_top.clear ();
+          m_topStart = rung.start + nBuckets * width;
+          NS_LOG_LOGIC ("rung 0 from top, width=" << width << ", nBuckets=" << nBuckets);
+          continue;
+        }
+
+      uint32_t r = m_nRungs - 1;
+      if (m_rungs[r].size == 0)
+        {
+          m_nRungs--;
+          continue;
+        }
+      Rung &rung = m_rungs[r];
+      while (rung.buckets[rung.current].empty ())
+        {
+          rung.current++;
+        }
+      NS_ASSERT (rung.current < rung.nBuckets);
+      uint32_t current = rung.current;
+      uint64_t start = GetCurrentStart (rung);
+      uint64_t width = rung.width;
+      uint32_t n = rung.buckets[current].size ();
+      rung.current++;
+      rung.size -= n;
+      if (n <= THRESHOLD || width == 1 || m_nRungs == MAX_RUNGS)
+        {
+          // Bottom is empty: this leaves an empty bucket behind
+          m_bottom.swap (rung.buckets[current]);
+          std::sort (m_bottom.begin (), m_bottom.end (), &IsLater);
+          return;
+        }
+
+      uint64_t childWidth = (width + n - 1) / n;
+      uint32_t nBuckets = (width + childWidth - 1) / childWidth;
+      InitRung (start, childWidth, nBuckets);
+      // InitRung may have moved the rungs
+      Bucket &bucket = m_rungs[r].buckets[current];
+      Rung &child = m_rungs[r + 1];
+      for (Bucket::const_iterator i = bucket.begin (); i != bucket.end (); ++i)
+        {
+          child.buckets[(i->key.m_ts - start) / childWidth].push_back (*i);
+        }
+      child.size = n;
+      bucket.clear ();
+      NS_LOG_LOGIC ("rung " << r + 1 << ", width=" << childWidth << ", nBuckets=" << nBuckets);
+    }
+}
+
+} // namespace ns3
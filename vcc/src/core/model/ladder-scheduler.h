@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a ladder queue event scheduler
+ *
+ * This event scheduler is an implementation of the ladder queue published
+ * in 2005 in "Ladder Queue: An O(1) Priority Queue Structure for Large-Scale
+ * Discrete Event Simulation" by Tang, Goh and Thng. Events are kept in three
+ * tiers:
+ *  - Top: an unsorted vector of the events beyond the end of the ladder,
+ *    with the bounds of their timestamps.
+ *  - Ladder: rungs of buckets, each rung covering one bucket of the rung
+ *    above it with narrower buckets. The buckets are unsorted vectors.
+ *  - Bottom: a small sorted vector of the earliest events, which is where
+ *    the events are removed from.
+ *
+ * When Bottom is empty, the first non empty bucket of the lowest rung is
+ * sorted into it, or, if it holds too many events, spread into a new rung
+ * whose bucket width is the width of that bucket divided by its number of
+ * events. When the ladder is empty, the first rung is built from Top, with
+ * a bucket width adapted to the mean distance between the events of Top.
+ * When too many events are inserted in the range of Bottom, it is spread
+ * into a new rung as well. An event is hence only sorted in a set of
+ * bounded size, and inserted in O(1) unless it falls in the range of
+ * Bottom.
+ *
+ * The rungs and their buckets are kept when they are emptied, so that the
+ * memory they hold is reused by the next ones.
+ */
+class LadderScheduler : public Scheduler
+{
+public:
+  static TypeId GetTypeId (void);
+
+  LadderScheduler ();
+  virtual ~LadderScheduler ();
+
+  virtual void Insert (const Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Event PeekNext (void) const;
+  virtual Event RemoveNext (void);
+  virtual void Remove (const Event &ev);
+
+private:
+  typedef std::vector<Scheduler::Event> Bucket;
+  struct Rung
+  {
+    // timestamp of the start of the first bucket
+    uint64_t start;
+    // duration of a bucket
+    uint64_t width;
+    // first bucket which may hold events
+    uint32_t current;
+    // number of buckets in use
+    uint32_t nBuckets;
+    // number of events in the rung
+    uint32_t size;
+    std::vector<Bucket> buckets;
+  };
+
+  void Refill (void);
+  void InitRung (uint64_t start, uint64_t width, uint32_t nBuckets);
+  void InsertInBottom (const Event &ev);
+  static bool Remove (Bucket *bucket, const Event &ev);
+  static inline uint64_t GetCurrentStart (const Rung &rung);
+
+  Bucket m_top;
+  // smallest and largest timestamps of the events of Top
+  uint64_t m_topMin;
+  uint64_t m_topMax;
+  // the events whose timestamp is at least this one belong to Top
+  uint64_t m_topStart;
+  std::vector<Rung> m_rungs;
+  // number of rungs in use
+  uint32_t m_nRungs;
+  // sorted in decreasing order, the earliest event at the back
+  Bucket m_bottom;
+  // number of events in queue
+  uint32_t m_size;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
@@ -26,6 +26,10 @@ protected:
     {
       (*m_function)();
     }
+    virtual struct Function GetFunction (void) const
+    {
+      return GetBytes (m_function);
+    }
 private:
     F m_function;
   } *ev = new EventFunctionImpl0 (f);
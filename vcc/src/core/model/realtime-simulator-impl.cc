@@ -85,6 +85,7 @@ RealtimeSimulatorImpl::RealtimeSimulatorImpl ()
   m_unscheduledEvents = 0;
 
   m_main = SystemThread::Self();
+  EventImpl::SetPoolThread ();
 
   // Be very careful not to do anything that would cause a change or assignment
   // of the underlying reference counts of m_synchronizer or you will be sorry.
@@ -420,6 +421,7 @@ RealtimeSimulatorImpl::Run (void)
 
   // Set the current threadId as the main threadId
   m_main = SystemThread::Self();
+  EventImpl::SetPoolThread ();
 
   m_stop = false;
   m_running = true;
@@ -1,4 +1,5 @@
 #include "rng-seed-manager.h"
+#include "rng-stream.h"
 #include "global-value.h"
 #include "attribute-helper.h"
 #include "integer.h"
@@ -49,6 +50,12 @@ uint64_t RngSeedManager::GetRun ()
   return run;
 }
 
+void RngSeedManager::ResetStreams (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  RngStream::ResetAll (GetSeed (), GetRun ());
+}
+
 uint64_t RngSeedManager::GetNextStreamIndex (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
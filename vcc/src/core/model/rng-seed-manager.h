@@ -60,6 +60,17 @@ public:
    */
   static uint64_t GetRun (void);
 
+  /**
+   * \brief Restart all the existing streams for the current seed and run
+   *
+   * Each stream starts again from the beginning of its substream for the
+   * current seed and run, as if it was created now. The branches of a
+   * snapshot, see Simulator::ScheduleSnapshot, call this after SetRun to
+   * draw independent numbers for the rest of the simulation, provided
+   * that the run differs from the one the warm up used.
+   */
+  static void ResetStreams (void);
+
   static uint64_t GetNextStreamIndex(void);
 
 };
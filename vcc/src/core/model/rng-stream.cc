@@ -47,6 +47,9 @@ const double two17 =      131072.0;
 const double two53 =      9007199254740992.0;
 const double fact =       5.9604644775390625e-8;     /* 1 / 2^24  */
 
+// the first of the streams which exist, for RngStream::ResetAll
+ns3::RngStream *g_streams = 0;
+
 const Matrix InvA1 = {          // Inverse of A1p0
   { 184888585.0,   0.0,  1945170933.0 },
   {         1.0,   0.0,           0.0 },
@@ -291,6 +294,64 @@ double RngStream::RandU01 ()
 }
 
 RngStream::RngStream (uint32_t seedNumber, uint64_t stream, uint64_t substream)
+  : m_stream (stream)
+{
+  Reset (seedNumber, substream);
+  Link ();
+}
+
+RngStream::RngStream(const RngStream& r)
+  : m_stream (r.m_stream)
+{
+  for (int i = 0; i < 6; ++i)
+    {
+      m_currentState[i] = r.m_currentState[i];
+    }
+  Link ();
+}
+
+RngStream &
+RngStream::operator = (const RngStream& r)
+{
+  // the links stay those of this stream
+  for (int i = 0; i < 6; ++i)
+    {
+      m_currentState[i] = r.m_currentState[i];
+    }
+  m_stream = r.m_stream;
+  return *this;
+}
+
+RngStream::~RngStream ()
+{
+  if (m_prev != 0)
+    {
+      m_prev->m_next = m_next;
+    }
+  else
+    {
+      g_streams = m_next;
+    }
+  if (m_next != 0)
+    {
+      m_next->m_prev = m_prev;
+    }
+}
+
+void
+RngStream::Link (void)
+{
+  m_prev = 0;
+  m_next = g_streams;
+  if (g_streams != 0)
+    {
+      g_streams->m_prev = this;
+    }
+  g_streams = this;
+}
+
+void
+RngStream::Reset (uint32_t seedNumber, uint64_t substream)
 {
   if (seedNumber >= m1 || seedNumber >= m2 || seedNumber == 0)
     {
@@ -300,15 +361,17 @@ RngStream::RngStream (uint32_t seedNumber, uint64_t stream, uint64_t substream)
     {
       m_currentState[i] = seedNumber;
     }
-  AdvanceNthBy (stream, 127, m_currentState);
+  AdvanceNthBy (m_stream, 127, m_currentState);
   AdvanceNthBy (substream, 76, m_currentState);
 }
 
-RngStream::RngStream(const RngStream& r)
+void
+RngStream::ResetAll (uint32_t seed, uint64_t substream)
 {
-  for (int i = 0; i < 6; ++i)
+  NS_LOG_FUNCTION (seed << substream);
+  for (RngStream *stream = g_streams; stream != 0; stream = stream->m_next)
     {
-      m_currentState[i] = r.m_currentState[i];
+      stream->Reset (seed, substream);
     }
 }
 
@@ -41,16 +41,32 @@ class RngStream
 public:
   RngStream (uint32_t seed, uint64_t stream, uint64_t substream);
   RngStream (const RngStream&);
+  RngStream &operator = (const RngStream&);
+  ~RngStream ();
   /**
    * Generate the next random number for this stream.
    * Uniformly distributed between 0 and 1.
    */
   double RandU01 (void);
+  /**
+   * \param seed the new seed
+   * \param substream the new substream
+   *
+   * Restart all the streams which exist from the beginning of the
+   * substream of the new seed, each one in the stream it was created in.
+   */
+  static void ResetAll (uint32_t seed, uint64_t substream);
 
 private:
+  void Reset (uint32_t seed, uint64_t substream);
   void AdvanceNthBy (uint64_t nth, int by, double state[6]);
+  void Link (void);
 
   double m_currentState[6];
+  uint64_t m_stream;
+  // the list of the streams which exist
+  RngStream *m_prev;
+  RngStream *m_next;
 };
 
 } // namespace ns3
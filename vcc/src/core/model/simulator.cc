@@ -32,10 +32,18 @@
 #include "log.h"
 
 #include <cmath>
+#include <cstdio>
 #include <fstream>
 #include <list>
+#include <set>
 #include <vector>
 #include <iostream>
+#ifdef HAVE_SYS_WAIT_H
+#include <cerrno>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#endif
 
 // Note:  Logging in this file is largely avoided due to the
 // number of calls that are made to these functions and the possibility
@@ -74,6 +82,13 @@ NodePrinter (std::ostream &os)
     }
 }
 
+const uint32_t Simulator::NO_BRANCH;
+
+/* the branch of the last snapshot which this process runs */
+static uint32_t g_branch = Simulator::NO_BRANCH;
+/* whether this process took a snapshot since Simulator::Destroy */
+static bool g_snapshotParent = false;
+
 static SimulatorImpl **PeekImpl (void)
 {
   static SimulatorImpl *impl = 0;
@@ -137,6 +152,7 @@ Simulator::Destroy (void)
   (*pimpl)->Destroy ();
   (*pimpl)->Unref ();
   *pimpl = 0;
+  g_snapshotParent = false;
 }
 
 void
@@ -175,6 +191,87 @@ Simulator::Stop (Time const &time)
   GetImpl ()->Stop (time);
 }
 
+#ifdef HAVE_SYS_WAIT_H
+static void
+TakeSnapshot (uint32_t nBranches, Callback<void, uint32_t> branch, uint32_t nJobs)
+{
+  NS_LOG_FUNCTION (nBranches << nJobs);
+  if (nJobs == 0)
+    {
+      long nCores = sysconf (_SC_NPROCESSORS_ONLN);
+      nJobs = nCores > 0 ? nCores : 1;
+    }
+  // each branch would write again what is buffered
+  std::cout.flush ();
+  std::cerr.flush ();
+  std::clog.flush ();
+  std::fflush (0);
+
+  std::set<pid_t> running;
+  uint32_t next = 0;
+  while (next < nBranches || !running.empty ())
+    {
+      if (next < nBranches && running.size () < nJobs)
+        {
+          pid_t pid = fork ();
+          if (pid < 0)
+            {
+              NS_FATAL_ERROR ("cannot fork the branch " << next);
+            }
+          if (pid == 0)
+            {
+              g_branch = next;
+              branch (next);
+              return;
+            }
+          running.insert (pid);
+          next++;
+          continue;
+        }
+      int status;
+      pid_t pid = waitpid (-1, &status, 0);
+      if (pid < 0)
+        {
+          if (errno == EINTR)
+            {
+              continue;
+            }
+          NS_FATAL_ERROR ("cannot wait for the branches of the snapshot");
+        }
+      if (running.erase (pid) == 1 && !(WIFEXITED (status) && WEXITSTATUS (status) == 0))
+        {
+          NS_LOG_WARN ("a branch of the snapshot failed, status " << status);
+        }
+    }
+  g_snapshotParent = true;
+  Simulator::Stop ();
+}
+#endif
+
+void
+Simulator::ScheduleSnapshot (Time const &time, uint32_t nBranches,
+                             Callback<void, uint32_t> branch, uint32_t nJobs)
+{
+  NS_LOG_FUNCTION (time << nBranches << nJobs);
+#ifdef HAVE_SYS_WAIT_H
+  DoSchedule (time, MakeEvent (&TakeSnapshot, nBranches, branch, nJobs));
+#else
+  NS_FATAL_ERROR ("snapshots need fork");
+#endif
+}
+
+uint32_t
+Simulator::GetBranch (void)
+{
+  return g_branch;
+}
+
+bool
+Simulator::IsSnapshotParent (void)
+{
+  return g_snapshotParent;
+}
+
 Time
 Simulator::Now (void)
 {
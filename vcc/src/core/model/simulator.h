@@ -25,6 +25,7 @@
 #include "event-impl.h"
 #include "make-event.h"
 #include "nstime.h"
+#include "callback.h"
 
 #include "deprecated.h"
 #include "object-factory.h"
@@ -128,6 +129,54 @@ public:
    */
   static void Stop (Time const &time);
 
+  /**
+   * \param time the delay after which the snapshot is taken
+   * \param nBranches the number of branches to run from the snapshot
+   * \param branch called in each branch with its index, before the
+   *        branch goes on with the simulation
+   * \param nJobs the number of branches which run at the same time, 0
+   *        for the number of processors
+   *
+   * At the given time, the process forks one child per branch, which
+   * shares its pages with copy on write, so that the branches share the
+   * set up and the warm up of the simulation. A branch typically draws
+   * new random numbers with RngSeedManager::SetRun and
+   * RngSeedManager::ResetStreams and changes the attributes of the
+   * traffic, then goes on with the simulation from the snapshot. The
+   * streams restart at the beginning of the substream of the run, so a
+   * branch which sets the run of the warm up replays its draws: the warm
+   * up should use a run which none of the branches use. The
+   * branches report their results themselves, through a pipe or a file,
+   * and should leave with _exit once they are done.
+   *
+   * The process which took the snapshot waits for all its branches, then
+   * stops: Simulator::Run returns and Simulator::IsSnapshotParent is true.
+   * Only the thread which runs the events goes on in the branches. The
+   * output buffered by the standard streams is flushed before forking.
+   * Snapshots need fork, hence they are not available on Windows.
+   */
+  static void ScheduleSnapshot (Time const &time, uint32_t nBranches,
+                                Callback<void, uint32_t> branch, uint32_t nJobs = 0);
+
+  /**
+   * \returns the index of the branch that this process runs, since the
+   *          last snapshot it comes from, or Simulator::NO_BRANCH if it
+   *          does not come from a snapshot.
+   */
+  static uint32_t GetBranch (void);
+
+  /**
+   * \returns true if the simulation stopped because this process took a
+   *          snapshot, whose branches are done, until Simulator::Destroy.
+   */
+  static bool IsSnapshotParent (void);
+
+  /**
+   * The value of Simulator::GetBranch in a process which does not come
+   * from a snapshot.
+   */
+  static const uint32_t NO_BRANCH = 0xffffffff;
+
   /**
    * Schedule an event to expire at the relative time "time"
    * is reached.  This can be thought of as scheduling an event
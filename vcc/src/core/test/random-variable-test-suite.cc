@@ -27,6 +27,8 @@
 #include "ns3/assert.h"
 #include "ns3/integer.h"
 #include "ns3/random-variable.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/rng-seed-manager.h"
 
 using namespace ns3;
 
@@ -129,6 +131,47 @@ RandomNumberSerializationTestCase::DoRun (void)
                          "Deserialize and Serialize \"Normal:0.1:0.2:0.15\" mismatch");
 }
 
+class ResetStreamsTestCase : public TestCase
+{
+public:
+  ResetStreamsTestCase ();
+  virtual ~ResetStreamsTestCase ()
+  {
+  }
+
+private:
+  virtual void DoRun (void);
+};
+
+ResetStreamsTestCase::ResetStreamsTestCase ()
+  : TestCase ("Check that the existing streams restart for a new run")
+{
+}
+
+void
+ResetStreamsTestCase::DoRun (void)
+{
+  uint64_t run = RngSeedManager::GetRun ();
+  RngSeedManager::SetRun (1);
+  Ptr<UniformRandomVariable> a = CreateObject<UniformRandomVariable> ();
+  a->SetStream (5);
+  double first = a->GetValue ();
+  a->GetValue ();
+
+  RngSeedManager::SetRun (2);
+  RngSeedManager::ResetStreams ();
+  double second = a->GetValue ();
+  Ptr<UniformRandomVariable> b = CreateObject<UniformRandomVariable> ();
+  b->SetStream (5);
+  NS_TEST_EXPECT_MSG_EQ (second, b->GetValue (), "the stream did not restart in the new run");
+  NS_TEST_EXPECT_MSG_NE (second, first, "the stream did not change of run");
+
+  RngSeedManager::SetRun (1);
+  RngSeedManager::ResetStreams ();
+  NS_TEST_EXPECT_MSG_EQ (a->GetValue (), first, "the stream did not restart from its beginning");
+  RngSeedManager::SetRun (run);
+}
+
 class BasicRandomNumberTestSuite : public TestSuite
 {
 public:
@@ -140,6 +183,7 @@ BasicRandomNumberTestSuite::BasicRandomNumberTestSuite ()
 {
   AddTestCase (new BasicRandomNumberTestCase);
   AddTestCase (new RandomNumberSerializationTestCase);
+  AddTestCase (new ResetStreamsTestCase);
 }
 
 static BasicRandomNumberTestSuite BasicRandomNumberTestSuite;
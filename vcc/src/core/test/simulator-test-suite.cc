@@ -17,12 +17,24 @@
  *
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
+#include "ns3/core-config.h"
 #include "ns3/test.h"
 #include "ns3/simulator.h"
 #include "ns3/list-scheduler.h"
 #include "ns3/heap-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/calendar-scheduler.h"
+#include "ns3/ladder-scheduler.h"
+#include "ns3/random-variable.h"
+#include "ns3/config.h"
+#include "ns3/string.h"
+#include <fstream>
+#include <sstream>
+#include <set>
+#include <vector>
+#ifdef HAVE_SYS_WAIT_H
+#include <unistd.h>
+#endif
 
 using namespace ns3;
 
@@ -168,6 +180,135 @@ SimulatorEventsTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (m_destroy, true, "Event should have run");
 }
 
+class SchedulerOrderTestCase : public TestCase
+{
+public:
+  SchedulerOrderTestCase (ObjectFactory schedulerFactory);
+private:
+  virtual void DoRun (void);
+  void Insert (uint64_t ts);
+  void RemoveNext (void);
+  void Remove (uint32_t i);
+
+  typedef std::set<Scheduler::EventKey> Keys;
+  ObjectFactory m_schedulerFactory;
+  Ptr<Scheduler> m_scheduler;
+  // the events in the scheduler, sorted, and in no order
+  Keys m_keys;
+  std::vector<Scheduler::EventKey> m_events;
+  uint64_t m_now;
+  uint32_t m_uid;
+};
+
+SchedulerOrderTestCase::SchedulerOrderTestCase (ObjectFactory schedulerFactory)
+  : TestCase ("Check the order of the events of " +
+              schedulerFactory.GetTypeId ().GetName () +
+              " with a mix of short and long delays and removals"),
+    m_schedulerFactory (schedulerFactory)
+{
+}
+
+void
+SchedulerOrderTestCase::Insert (uint64_t ts)
+{
+  Scheduler::Event ev;
+  ev.impl = 0;
+  ev.key.m_ts = ts;
+  ev.key.m_uid = m_uid++;
+  ev.key.m_context = 0;
+  m_scheduler->Insert (ev);
+  m_keys.insert (ev.key);
+  m_events.push_back (ev.key);
+}
+
+void
+SchedulerOrderTestCase::RemoveNext (void)
+{
+  Scheduler::EventKey expected = *m_keys.begin ();
+  Scheduler::Event peek = m_scheduler->PeekNext ();
+  Scheduler::Event ev = m_scheduler->RemoveNext ();
+  NS_TEST_ASSERT_MSG_EQ (peek.key.m_uid, ev.key.m_uid, "PeekNext and RemoveNext disagree");
+  NS_TEST_ASSERT_MSG_EQ (ev.key.m_uid, expected.m_uid, "not the earliest event");
+  NS_TEST_ASSERT_MSG_EQ (ev.key.m_ts, expected.m_ts, "not the earliest event");
+  m_keys.erase (m_keys.begin ());
+  for (uint32_t i = 0; i < m_events.size (); i++)
+    {
+      if (m_events[i].m_uid == ev.key.m_uid)
+        {
+          m_events[i] = m_events.back ();
+          m_events.pop_back ();
+          break;
+        }
+    }
+  m_now = ev.key.m_ts;
+}
+
+void
+SchedulerOrderTestCase::Remove (uint32_t i)
+{
+  Scheduler::Event ev;
+  ev.impl = 0;
+  ev.key = m_events[i];
+  m_scheduler->Remove (ev);
+  m_keys.erase (ev.key);
+  m_events[i] = m_events.back ();
+  m_events.pop_back ();
+}
+
+void
+SchedulerOrderTestCase::DoRun (void)
+{
+  m_scheduler = m_schedulerFactory.Create<Scheduler> ();
+  m_now = 0;
+  m_uid = 0;
+  UniformVariable rng;
+  // a backlog of distant events, then mostly short delays as the wifi
+  // backoffs and timeouts, with ties, bursts and removals
+  for (uint32_t i = 0; i < 2000; i++)
+    {
+      Insert (rng.GetInteger (0, 10000000));
+    }
+  for (uint32_t i = 0; i < 20000 && IsStatusSuccess (); i++)
+    {
+      double x = rng.GetValue ();
+      if (x < 0.05)
+        {
+          Insert (m_now);
+        }
+      else if (x < 0.4)
+        {
+          Insert (m_now + rng.GetInteger (0, 1000));
+        }
+      else if (x < 0.5)
+        {
+          Insert (m_now + rng.GetInteger (0, 10000000));
+        }
+      else if (x < 0.505)
+        {
+          // a burst, as the receptions of a broadcast
+          for (uint32_t j = 0; j < 200; j++)
+            {
+              Insert (m_now + 1000 + rng.GetInteger (0, 50));
+            }
+        }
+      else if (x < 0.6 && !m_events.empty ())
+        {
+          Remove (rng.GetInteger (0, m_events.size () - 1));
+        }
+      else if (!m_keys.empty ())
+        {
+          RemoveNext ();
+        }
+      NS_TEST_ASSERT_MSG_EQ (m_scheduler->IsEmpty (), m_keys.empty (), "wrong emptiness");
+    }
+  while (!m_keys.empty () && IsStatusSuccess ())
+    {
+      RemoveNext ();
+    }
+  NS_TEST_ASSERT_MSG_EQ (m_scheduler->IsEmpty (), true, "events left");
+  m_scheduler = 0;
+}
+
 class SimulatorTemplateTestCase : public TestCase
 {
 public:
@@ -459,6 +600,211 @@ SimulatorTemplateTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+static void
+PoolEvent (int, int)
+{
+}
+
+/* events of N words more than EventImpl */
+template <int N>
+class PaddedEvent : public EventImpl
+{
+  virtual void Notify (void) {}
+  uint64_t m_pad[N];
+};
+
+class EventImplPoolTestCase : public TestCase
+{
+public:
+  EventImplPoolTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+EventImplPoolTestCase::EventImplPoolTestCase ()
+  : TestCase ("Check that the events reuse the blocks of the deleted ones")
+{
+}
+
+void
+EventImplPoolTestCase::DoRun (void)
+{
+  // the simulator makes this thread the one which uses the free lists
+  Simulator::Now ();
+
+  // 40 and 48 bytes (36 and 44 on 32 bit systems) are in the same free
+  // list, but not in the same bin of the global allocator
+  EventImpl *a = new PaddedEvent<2> ();
+  void *block = a;
+  a->Unref ();
+  EventImpl *b = new PaddedEvent<3> ();
+  NS_TEST_EXPECT_MSG_EQ (static_cast<void *> (b), block, "the block of the deleted event is not reused");
+  EventImpl *c = new PaddedEvent<4> ();
+  NS_TEST_EXPECT_MSG_NE (static_cast<void *> (c), block, "two events share a block");
+  b->Unref ();
+  c->Unref ();
+
+  // the events which ran and the canceled ones go back to the free lists
+  EventId id = Simulator::Schedule (Seconds (1.0), &PoolEvent, 1, 2);
+  block = id.PeekEventImpl ();
+  Simulator::Cancel (id);
+  id = EventId ();
+  Simulator::Run ();
+  a = MakeEvent (&PoolEvent, 3, 4);
+  NS_TEST_EXPECT_MSG_EQ (static_cast<void *> (a), block, "the block of the canceled event is not reused");
+  a->Unref ();
+  Simulator::Destroy ();
+}
+
+class SimulatorProfileTestCase : public TestCase
+{
+public:
+  SimulatorProfileTestCase ();
+  void A (void);
+  void B (void);
+private:
+  virtual void DoRun (void);
+};
+
+SimulatorProfileTestCase::SimulatorProfileTestCase ()
+  : TestCase ("Check the profile of the events")
+{
+}
+
+void
+SimulatorProfileTestCase::A (void)
+{
+}
+
+void
+SimulatorProfileTestCase::B (void)
+{
+}
+
+void
+SimulatorProfileTestCase::DoRun (void)
+{
+  std::string filename = CreateTempDirFilename ("profile");
+  Simulator::Destroy ();
+  Config::SetDefault ("ns3::DefaultSimulatorImpl::ProfileFile", StringValue (filename));
+  // A and B are events of the same type, which call different methods
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      Simulator::Schedule (Seconds (1.0), &SimulatorProfileTestCase::A, this);
+    }
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      EventId id = Simulator::Schedule (Seconds (2.0), &SimulatorProfileTestCase::B, this);
+      if (i == 0)
+        {
+          Simulator::Cancel (id);
+        }
+    }
+  Simulator::Run ();
+  Simulator::Destroy ();
+  Config::SetDefault ("ns3::DefaultSimulatorImpl::ProfileFile", StringValue (""));
+
+  std::ifstream is (filename.c_str ());
+  NS_TEST_ASSERT_MSG_EQ (is.is_open (), true, "the profile was not written");
+  std::string line;
+  std::getline (is, line);
+  NS_TEST_EXPECT_MSG_EQ (line.find ("# 7 events,"), 0, "wrong number of events: " << line);
+  NS_TEST_EXPECT_MSG_NE (line.find ("7 events in queue at most"), std::string::npos, "wrong depth: " << line);
+  std::getline (is, line);
+  uint32_t entries = 0;
+  while (std::getline (is, line) && line[0] != '#')
+    {
+      std::istringstream iss (line);
+      double wall, percent, perEvent, delay;
+      uint32_t events, cancelled;
+      iss >> wall >> percent >> events >> cancelled >> perEvent >> delay;
+      NS_TEST_ASSERT_MSG_EQ (iss.fail (), false, "cannot parse " << line);
+      if (events == 4)
+        {
+          NS_TEST_EXPECT_MSG_EQ (cancelled, 0, "wrong number of cancelled events of A");
+          NS_TEST_EXPECT_MSG_EQ_TOL (delay, 1.0, 1e-9, "wrong delay of A");
+        }
+      else
+        {
+          NS_TEST_EXPECT_MSG_EQ (events, 3, "wrong number of events: " << line);
+          NS_TEST_EXPECT_MSG_EQ (cancelled, 1, "wrong number of cancelled events of B");
+          NS_TEST_EXPECT_MSG_EQ_TOL (delay, 2.0, 1e-9, "wrong delay of B");
+        }
+      entries++;
+    }
+  NS_TEST_EXPECT_MSG_EQ (entries, 2, "the events of A and B were not told apart");
+  // the first event is sampled, with all the events in queue
+  std::getline (is, line);
+  NS_TEST_EXPECT_MSG_EQ (line, "1 7", "wrong sample of the depth of the queue");
+  std::ifstream folded ((filename + ".folded").c_str ());
+  NS_TEST_EXPECT_MSG_EQ (folded.is_open (), true, "the folded profile was not written");
+}
+
+#ifdef HAVE_SYS_WAIT_H
+class SimulatorSnapshotTestCase : public TestCase
+{
+public:
+  SimulatorSnapshotTestCase ();
+  void Count (void);
+  void Branch (uint32_t branch);
+private:
+  virtual void DoRun (void);
+  uint32_t m_count;
+};
+
+SimulatorSnapshotTestCase::SimulatorSnapshotTestCase ()
+  : TestCase ("Check that the branches of a snapshot go on from it")
+{
+}
+
+void
+SimulatorSnapshotTestCase::Count (void)
+{
+  m_count++;
+}
+
+void
+SimulatorSnapshotTestCase::Branch (uint32_t branch)
+{
+  m_count += 100 * (branch + 1);
+}
+
+void
+SimulatorSnapshotTestCase::DoRun (void)
+{
+  int fds[2];
+  NS_TEST_ASSERT_MSG_EQ (pipe (fds), 0, "cannot create a pipe");
+  m_count = 0;
+  Simulator::Schedule (Seconds (1.0), &SimulatorSnapshotTestCase::Count, this);
+  Simulator::ScheduleSnapshot (Seconds (2.0), 3,
+                               MakeCallback (&SimulatorSnapshotTestCase::Branch, this), 2);
+  Simulator::Schedule (Seconds (3.0), &SimulatorSnapshotTestCase::Count, this);
+  Simulator::Run ();
+  if (Simulator::GetBranch () != Simulator::NO_BRANCH)
+    {
+      uint32_t record[2] = { Simulator::GetBranch (), m_count };
+      ssize_t n = write (fds[1], record, sizeof (record));
+      _exit (n == sizeof (record) ? 0 : 1);
+    }
+  close (fds[1]);
+  NS_TEST_EXPECT_MSG_EQ (Simulator::IsSnapshotParent (), true, "the snapshot did not stop the simulation");
+  NS_TEST_EXPECT_MSG_EQ (m_count, 1, "the simulation went on after the snapshot");
+  Simulator::Destroy ();
+  NS_TEST_EXPECT_MSG_EQ (Simulator::IsSnapshotParent (), false, "the snapshot outlived the simulation");
+
+  std::set<uint32_t> branches;
+  uint32_t record[2];
+  while (read (fds[0], record, sizeof (record)) == sizeof (record))
+    {
+      branches.insert (record[0]);
+      NS_TEST_EXPECT_MSG_EQ (record[1], 100 * (record[0] + 1) + 2, "wrong events in branch " << record[0]);
+    }
+  close (fds[0]);
+  NS_TEST_EXPECT_MSG_EQ (branches.size (), 3, "the branches did not all report");
+  NS_TEST_EXPECT_MSG_EQ (Simulator::GetBranch (), Simulator::NO_BRANCH, "the parent is a branch");
+}
+#endif
+
 class SimulatorTestSuite : public TestSuite
 {
 public:
@@ -475,5 +821,22 @@ public:
     AddTestCase (new SimulatorEventsTestCase (factory));
     factory.SetTypeId (CalendarScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory));
+    factory.SetTypeId (LadderScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory));
+
+    factory.SetTypeId (HeapScheduler::GetTypeId ());
+    AddTestCase (new SchedulerOrderTestCase (factory));
+    factory.SetTypeId (MapScheduler::GetTypeId ());
+    AddTestCase (new SchedulerOrderTestCase (factory));
+    factory.SetTypeId (CalendarScheduler::GetTypeId ());
+    AddTestCase (new SchedulerOrderTestCase (factory));
+    factory.SetTypeId (LadderScheduler::GetTypeId ());
+    AddTestCase (new SchedulerOrderTestCase (factory));
+
+    AddTestCase (new EventImplPoolTestCase ());
+    AddTestCase (new SimulatorProfileTestCase ());
+#ifdef HAVE_SYS_WAIT_H
+    AddTestCase (new SimulatorSnapshotTestCase ());
+#endif
   }
 } g_simulatorTestSuite;
@@ -225,6 +225,87 @@ ThreadedSimulatorEventsTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (m_a, m_d, "Bad scheduling");
 }
 
+/* more events than the inbox of DefaultSimulatorImpl holds */
+#define INBOX_EVENTS 5000
+
+class ThreadedInboxOrderTestCase : public TestCase
+{
+public:
+  ThreadedInboxOrderTestCase ();
+  static void Produce (std::pair<ThreadedInboxOrderTestCase *, uint32_t> context);
+  void Consume (uint32_t thread, uint32_t i);
+  void Poll (void);
+  uint32_t m_next[2];
+  bool m_inOrder;
+
+private:
+  virtual void DoRun (void);
+};
+
+ThreadedInboxOrderTestCase::ThreadedInboxOrderTestCase ()
+  : TestCase ("Check that the events of each thread run in order when they do not fit in the inbox")
+{
+}
+
+void
+ThreadedInboxOrderTestCase::Produce (std::pair<ThreadedInboxOrderTestCase *, uint32_t> context)
+{
+  for (uint32_t i = 0; i < INBOX_EVENTS; i++)
+    {
+      Simulator::ScheduleWithContext (context.second, MicroSeconds (1),
+                                      &ThreadedInboxOrderTestCase::Consume, context.first, context.second, i);
+    }
+}
+
+void
+ThreadedInboxOrderTestCase::Consume (uint32_t thread, uint32_t i)
+{
+  if (i != m_next[thread])
+    {
+      m_inOrder = false;
+    }
+  m_next[thread]++;
+}
+
+void
+ThreadedInboxOrderTestCase::Poll (void)
+{
+  if (m_next[0] + m_next[1] < 2 * INBOX_EVENTS && Simulator::Now () < Seconds (1))
+    {
+      Simulator::Schedule (MicroSeconds (1), &ThreadedInboxOrderTestCase::Poll, this);
+    }
+}
+
+void
+ThreadedInboxOrderTestCase::DoRun (void)
+{
+  m_next[0] = 0;
+  m_next[1] = 0;
+  m_inOrder = true;
+  // the simulator is created by this thread
+  Simulator::Now ();
+
+  // all the events are scheduled before the simulator runs
+  Ptr<SystemThread> first = Create<SystemThread> (
+      MakeBoundCallback (&ThreadedInboxOrderTestCase::Produce,
+                         std::pair<ThreadedInboxOrderTestCase *, uint32_t> (this, 0)));
+  first->Start ();
+  first->Join ();
+  // and while it runs
+  Ptr<SystemThread> second = Create<SystemThread> (
+      MakeBoundCallback (&ThreadedInboxOrderTestCase::Produce,
+                         std::pair<ThreadedInboxOrderTestCase *, uint32_t> (this, 1)));
+  second->Start ();
+  Simulator::Schedule (MicroSeconds (1), &ThreadedInboxOrderTestCase::Poll, this);
+  Simulator::Run ();
+  second->Join ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_inOrder, true, "the events of a thread were reordered");
+  NS_TEST_EXPECT_MSG_EQ (m_next[0], INBOX_EVENTS, "events were lost");
+  NS_TEST_EXPECT_MSG_EQ (m_next[1], INBOX_EVENTS, "events were lost");
+}
+
 class ThreadedSimulatorTestSuite : public TestSuite
 {
 public:
@@ -241,7 +322,8 @@ public:
       "ns3::ListScheduler",
       "ns3::HeapScheduler",
       "ns3::MapScheduler",
-      "ns3::CalendarScheduler"
+      "ns3::CalendarScheduler",
+      "ns3::LadderScheduler"
     };
     unsigned int threadcounts[] = {
       0,
@@ -262,5 +344,6 @@ public:
               }
           }
       }
+    AddTestCase (new ThreadedInboxOrderTestCase ());
   }
 } g_threadedSimulatorTestSuite;
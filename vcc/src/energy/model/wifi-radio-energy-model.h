@@ -55,7 +55,7 @@ public:
    *
    * Defined in ns3::WifiPhyListener
    */
-  virtual void NotifyRxStart (Time rxDuration, WifiMacHeader hdr, Ptr<const Packet> packet);
+  virtual void NotifyRxStart (Time rxDuration, const WifiMacHeader &hdr, Ptr<const Packet> packet);
 
   /**
    * \brief Switches the WifiRadioEnergyModel back to IDLE state.
@@ -85,7 +85,7 @@ public:
    *
    * Defined in ns3::WifiPhyListener
    */
-  virtual void NotifyTxStart (Time duration, WifiMacHeader hdr);
+  virtual void NotifyTxStart (Time duration, const WifiMacHeader &hdr);
 
   /**
    * \param duration the expected busy duration.
@@ -0,0 +1,89 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <vector>
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/net-device.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/ipv4-interface.h"
+#include "arp-cache-helper.h"
+
+NS_LOG_COMPONENT_DEFINE ("ArpCacheHelper");
+
+namespace ns3 {
+
+ArpCacheHelper::ArpCacheHelper ()
+  : m_aliveTimeout (Seconds (3600 * 24 * 365))
+{
+}
+
+void
+ArpCacheHelper::SetAliveTimeout (Time aliveTimeout)
+{
+  m_aliveTimeout = aliveTimeout;
+}
+
+Ptr<ArpCache>
+ArpCacheHelper::PopulateStatic (NodeContainer c) const
+{
+  Ptr<ArpCache> arp = CreateObject<ArpCache> ();
+  arp->SetAliveTimeout (m_aliveTimeout);
+
+  std::vector<Ptr<Ipv4Interface> > interfaces;
+  for (NodeContainer::Iterator i = c.Begin (); i != c.End (); ++i)
+    {
+      Ptr<Ipv4L3Protocol> ip = (*i)->GetObject<Ipv4L3Protocol> ();
+      NS_ASSERT_MSG (ip != 0, "node " << (*i)->GetId () << " has no IPv4 stack");
+      for (uint32_t j = 0; j < ip->GetNInterfaces (); ++j)
+        {
+          Ptr<Ipv4Interface> iface = ip->GetInterface (j);
+          Ptr<NetDevice> device = iface->GetDevice ();
+          if (!device->NeedsArp ())
+            {
+              continue;
+            }
+          interfaces.push_back (iface);
+
+          for (uint32_t k = 0; k < iface->GetNAddresses (); ++k)
+            {
+              Ipv4Address ipAddr = iface->GetAddress (k).GetLocal ();
+              if (arp->Lookup (ipAddr) != 0)
+                {
+                  NS_LOG_WARN ("duplicate address " << ipAddr << ", keep the first one");
+                  continue;
+                }
+              arp->Add (ipAddr)->MarkResolved (device->GetAddress ());
+              NS_LOG_LOGIC ("add (" << ipAddr << ", " << device->GetAddress () << ")");
+            }
+        }
+    }
+
+  for (std::vector<Ptr<Ipv4Interface> >::const_iterator i = interfaces.begin ();
+       i != interfaces.end (); ++i)
+    {
+      (*i)->SetArpCache (arp);
+    }
+  return arp;
+}
+
+Ptr<ArpCache>
+ArpCacheHelper::PopulateStatic (void) const
+{
+  return PopulateStatic (NodeContainer::GetGlobal ());
+}
+
+} // namespace ns3
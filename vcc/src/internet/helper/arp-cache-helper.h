@@ -0,0 +1,73 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef ARP_CACHE_HELPER_H
+#define ARP_CACHE_HELPER_H
+
+#include "ns3/ptr.h"
+#include "ns3/nstime.h"
+#include "ns3/node-container.h"
+#include "ns3/arp-cache.h"
+
+namespace ns3 {
+
+/**
+ * \brief Helper class that fills the ARP caches of a set of nodes
+ * before the simulation starts.
+ *
+ * Simulations which do not want to model address resolution can use
+ * this helper to give every IPv4 interface the MAC address of every
+ * other one, so that no ARP request is ever sent.
+ */
+class ArpCacheHelper
+{
+public:
+  ArpCacheHelper ();
+
+  /**
+   * \param aliveTimeout how long the static entries stay valid, one
+   * year by default.
+   */
+  void SetAliveTimeout (Time aliveTimeout);
+
+  /**
+   * \param c the nodes to populate, their IPv4 stack must be installed
+   * and their addresses assigned
+   * \returns the cache shared by the interfaces of these nodes
+   *
+   * Build a single ns3::ArpCache holding an alive entry for every
+   * address of every interface of these nodes which needs ARP, and
+   * set this cache on all of these interfaces. The interfaces and
+   * their devices are reached directly through ns3::Ipv4L3Protocol,
+   * without going through the attribute system, so the cost is linear
+   * in the number of interfaces.
+   */
+  Ptr<ArpCache> PopulateStatic (NodeContainer c) const;
+  /**
+   * \returns the cache shared by the interfaces of all the nodes
+   *
+   * Same as PopulateStatic (NodeContainer) for all the nodes of the
+   * simulation.
+   */
+  Ptr<ArpCache> PopulateStatic (void) const;
+
+private:
+  Time m_aliveTimeout;
+};
+
+} // namespace ns3
+
+#endif /* ARP_CACHE_HELPER_H */
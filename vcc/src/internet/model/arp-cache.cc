@@ -305,6 +305,16 @@ ArpCache::Entry::MarkAlive (Address macAddress)
   UpdateSeen ();
 }
 
+void
+ArpCache::Entry::MarkResolved (Address macAddress)
+{
+  NS_LOG_FUNCTION (this << macAddress);
+  NS_ASSERT (m_state == ALIVE && m_pending.empty ());
+  m_macAddress = macAddress;
+  ClearRetries ();
+  UpdateSeen ();
+}
+
 bool
 ArpCache::Entry::UpdateWaitReply (Ptr<Packet> waiting)
 {
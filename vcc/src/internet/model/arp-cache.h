@@ -129,6 +129,14 @@ public:
      * \param macAddress
      */
     void MarkAlive (Address macAddress);
+    /**
+     * \param macAddress
+     *
+     * Make a new entry alive with this MAC address, as if an ARP reply
+     * had been received, without queueing any packet or starting the
+     * wait reply timer. Used to fill a cache before the simulation.
+     */
+    void MarkResolved (Address macAddress);
     /**
      * \param waiting
      */
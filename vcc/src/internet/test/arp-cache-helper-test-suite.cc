@@ -0,0 +1,109 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simple-channel.h"
+#include "ns3/error-model.h"
+#include "ns3/mac48-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/ipv4-interface.h"
+#include "ns3/arp-cache-helper.h"
+
+using namespace ns3;
+
+namespace {
+
+// a device which resolves its neighbors with ARP
+class ArpNetDevice : public SimpleNetDevice
+{
+public:
+  virtual bool NeedsArp (void) const
+  {
+    return true;
+  }
+};
+
+}
+
+class ArpCacheHelperTestCase : public TestCase
+{
+public:
+  ArpCacheHelperTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+ArpCacheHelperTestCase::ArpCacheHelperTestCase ()
+  : TestCase ("Populate a shared static ARP cache")
+{
+}
+
+void
+ArpCacheHelperTestCase::DoRun (void)
+{
+  NodeContainer nodes;
+  nodes.Create (3);
+  NetDeviceContainer devices;
+  for (uint32_t i = 0; i < nodes.GetN (); ++i)
+    {
+      Ptr<ArpNetDevice> device = CreateObject<ArpNetDevice> ();
+      device->SetAddress (Mac48Address::Allocate ());
+      nodes.Get (i)->AddDevice (device);
+      devices.Add (device);
+    }
+
+  InternetStackHelper stack;
+  stack.Install (nodes);
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer interfaces = address.Assign (devices);
+
+  ArpCacheHelper helper;
+  Ptr<ArpCache> arp = helper.PopulateStatic (nodes);
+
+  for (uint32_t i = 0; i < nodes.GetN (); ++i)
+    {
+      Ptr<Ipv4L3Protocol> ip = nodes.Get (i)->GetObject<Ipv4L3Protocol> ();
+      uint32_t index = ip->GetInterfaceForDevice (devices.Get (i));
+      NS_TEST_EXPECT_MSG_EQ (ip->GetInterface (index)->GetArpCache (), arp, "cache shared by node " << i);
+      NS_TEST_EXPECT_MSG_NE (ip->GetInterface (0)->GetArpCache (), arp, "loopback does not need ARP");
+
+      ArpCache::Entry *entry = arp->Lookup (interfaces.GetAddress (i));
+      NS_TEST_ASSERT_MSG_NE (entry, 0, "entry of node " << i);
+      NS_TEST_EXPECT_MSG_EQ (entry->IsAlive (), true, "entry of node " << i << " is alive");
+      NS_TEST_EXPECT_MSG_EQ (entry->GetMacAddress (), devices.Get (i)->GetAddress (), "address of node " << i);
+      NS_TEST_EXPECT_MSG_EQ (entry->DequeuePending (), 0, "no packet pending");
+    }
+  NS_TEST_EXPECT_MSG_EQ (arp->Lookup (Ipv4Address ("127.0.0.1")), 0, "no loopback entry");
+
+  Simulator::Destroy ();
+}
+
+class ArpCacheHelperTestSuite : public TestSuite
+{
+public:
+  ArpCacheHelperTestSuite ()
+    : TestSuite ("arp-cache-helper", UNIT)
+  {
+    AddTestCase (new ArpCacheHelperTestCase ());
+  }
+} g_arpCacheHelperTestSuite;
@@ -241,6 +241,23 @@ Mac48Address Mac48Address::GetMulticast (Ipv6Address addr)
   return etherAddr;
 }
 
+size_t Mac48AddressHash::operator() (Mac48Address const &x) const
+{
+  uint8_t ad[6];
+  x.CopyTo (ad);
+  size_t h = 0;
+  for (uint8_t i = 0; i < 6; i++)
+    {
+      h = h * 31 + ad[i];
+    }
+  return h;
+}
+
+size_t Mac48AddressTidHash::operator() (Mac48AddressTid const &x) const
+{
+  return Mac48AddressHash () (x.address) * 16 + x.tid;
+}
+
 std::ostream& operator<< (std::ostream& os, const Mac48Address & address)
 {
   uint8_t ad[6];
@@ -161,6 +161,39 @@ inline bool operator < (const Mac48Address &a, const Mac48Address &b)
   return memcmp (a.m_address, b.m_address, 6) < 0;
 }
 
+/**
+ * \brief Hash function class for MAC-48 addresses.
+ */
+class Mac48AddressHash : public std::unary_function<Mac48Address, size_t>
+{
+public:
+  size_t operator() (Mac48Address const &x) const;
+};
+
+/**
+ * \brief A MAC-48 address and a traffic identifier, to key the state
+ * kept per peer and TID.
+ */
+struct Mac48AddressTid
+{
+  Mac48Address address;
+  uint8_t tid;
+};
+
+inline bool operator == (const Mac48AddressTid &a, const Mac48AddressTid &b)
+{
+  return a.tid == b.tid && a.address == b.address;
+}
+
+/**
+ * \brief Hash function class for a MAC-48 address and a TID.
+ */
+class Mac48AddressTidHash : public std::unary_function<Mac48AddressTid, size_t>
+{
+public:
+  size_t operator() (Mac48AddressTid const &x) const;
+};
+
 std::ostream& operator<< (std::ostream& os, const Mac48Address & address);
 std::istream& operator>> (std::istream& is, Mac48Address & address);
 
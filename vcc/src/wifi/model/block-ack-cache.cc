@@ -111,16 +111,18 @@ BlockAckCache::FillBlockAckBitmap (CtrlBAckResponseHeader *blockAckHeader)
     }
   else if (blockAckHeader->IsCompressed ())
     {
+      // the entries out of the window are stale, the request may start
+      // before it
       uint32_t i = blockAckHeader->GetStartingSequence ();
       uint32_t end = (i + m_winSize - 1) % 4096;
       for (; i != end; i = (i + 1) % 4096)
         {
-          if (m_bitmap[i] == 1)
+          if (IsInWindow (i) && m_bitmap[i] == 1)
             {
               blockAckHeader->SetReceivedPacket (i);
             }
         }
-      if (m_bitmap[i] == 1)
+      if (IsInWindow (i) && m_bitmap[i] == 1)
         {
           blockAckHeader->SetReceivedPacket (i);
         }
@@ -0,0 +1,210 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <vector>
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include "channel-address-registry.h"
+#include "wifi-net-device.h"
+#include "regular-data-wifi-mac.h"
+#include "regular-ctrl-wifi-mac.h"
+
+NS_LOG_COMPONENT_DEFINE("ChannelAddressRegistry");
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED(ChannelAddressRegistry);
+
+TypeId ChannelAddressRegistry::GetTypeId(void)
+{
+	static TypeId tid = TypeId("ns3::ChannelAddressRegistry").SetParent<Object>().AddConstructor<
+			ChannelAddressRegistry>();
+	return tid;
+}
+
+ChannelAddressRegistry::ChannelAddressRegistry() :
+		m_nNodes(0)
+{
+	NS_LOG_FUNCTION (this);
+}
+
+ChannelAddressRegistry::~ChannelAddressRegistry()
+{
+	NS_LOG_FUNCTION (this);
+}
+
+void ChannelAddressRegistry::DoDispose(void)
+{
+	NS_LOG_FUNCTION (this);
+	Flush();
+	Object::DoDispose();
+}
+
+void ChannelAddressRegistry::Install(NodeContainer c)
+{
+	for (NodeContainer::Iterator i = c.Begin(); i != c.End(); ++i)
+	{
+		Install(*i);
+	}
+}
+
+void ChannelAddressRegistry::Install(Ptr<Node> node)
+{
+	NS_LOG_FUNCTION (this << node);
+
+	bool bHasData = false;
+	bool bHasCtrl = false;
+	Mac48Address dataAddr;
+	Mac48Address ctrlAddr;
+	for (uint32_t i = 0; i < node->GetNDevices(); ++i)
+	{
+		Ptr<WifiNetDevice> device = DynamicCast<WifiNetDevice>(
+				node->GetDevice(i));
+		if (device == 0)
+		{
+			continue;
+		}
+
+		Ptr<WifiMac> mac = device->GetMac();
+		if (DynamicCast<RegularDataWifiMac>(mac) != 0)
+		{
+			dataAddr = mac->GetAddress();
+			bHasData = true;
+		}
+		else if (DynamicCast<RegularCtrlWifiMac>(mac) != 0)
+		{
+			ctrlAddr = mac->GetAddress();
+			bHasCtrl = true;
+		}
+	}
+
+	if (!bHasData || !bHasCtrl)
+	{
+		NS_LOG_WARN("node " << node->GetId ()
+				<< " does not own both a data and a ctrl device, ignore it");
+		return;
+	}
+
+	Add(node, dataAddr, ctrlAddr);
+}
+
+void ChannelAddressRegistry::Add(Ptr<Node> node, Mac48Address dataAddr,
+		Mac48Address ctrlAddr)
+{
+	NS_LOG_FUNCTION (this << node << dataAddr << ctrlAddr);
+	NS_ASSERT(dataAddr != ctrlAddr);
+
+	Remove(dataAddr);
+	Remove(ctrlAddr);
+
+	Entry *entry = new Entry();
+	entry->node = node;
+	entry->dataAddr = dataAddr;
+	entry->ctrlAddr = ctrlAddr;
+	m_entries[dataAddr] = entry;
+	m_entries[ctrlAddr] = entry;
+	++m_nNodes;
+}
+
+void ChannelAddressRegistry::Remove(Mac48Address addr)
+{
+	EntriesI it = m_entries.find(addr);
+	if (it == m_entries.end())
+	{
+		return;
+	}
+
+	Entry *entry = it->second;
+	m_entries.erase(entry->dataAddr);
+	m_entries.erase(entry->ctrlAddr);
+	delete entry;
+	--m_nNodes;
+}
+
+void ChannelAddressRegistry::Flush(void)
+{
+	// each entry is referenced twice, collect it through its data address only
+	std::vector<Entry *> entries;
+	for (EntriesI it = m_entries.begin(); it != m_entries.end(); ++it)
+	{
+		if (it->first == it->second->dataAddr)
+		{
+			entries.push_back(it->second);
+		}
+	}
+	m_entries.clear();
+	for (std::vector<Entry *>::iterator i = entries.begin(); i != entries.end();
+			++i)
+	{
+		delete *i;
+	}
+	m_nNodes = 0;
+}
+
+const ChannelAddressRegistry::Entry *
+ChannelAddressRegistry::Lookup(Mac48Address addr) const
+{
+	EntriesCI it = m_entries.find(addr);
+	if (it == m_entries.end())
+	{
+		return 0;
+	}
+	return it->second;
+}
+
+bool ChannelAddressRegistry::FindNode(Mac48Address addr, Ptr<Node> &node) const
+{
+	const Entry *entry = Lookup(addr);
+	if (entry == 0)
+	{
+		return false;
+	}
+	node = entry->node;
+	return true;
+}
+
+bool ChannelAddressRegistry::GetDataAddress(Mac48Address addr,
+		Mac48Address &dataAddr) const
+{
+	const Entry *entry = Lookup(addr);
+	if (entry == 0)
+	{
+		return false;
+	}
+	dataAddr = entry->dataAddr;
+	return true;
+}
+
+bool ChannelAddressRegistry::GetCtrlAddress(Mac48Address addr,
+		Mac48Address &ctrlAddr) const
+{
+	const Entry *entry = Lookup(addr);
+	if (entry == 0)
+	{
+		return false;
+	}
+	ctrlAddr = entry->ctrlAddr;
+	return true;
+}
+
+uint32_t ChannelAddressRegistry::GetN(void) const
+{
+	return m_nNodes;
+}
+
+} // namespace ns3
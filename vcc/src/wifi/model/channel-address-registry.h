@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef CHANNEL_ADDRESS_REGISTRY_H
+#define CHANNEL_ADDRESS_REGISTRY_H
+
+#include <stdint.h>
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+#include "ns3/node.h"
+#include "ns3/node-container.h"
+#include "ns3/mac48-address.h"
+#include "ns3/sgi-hashmap.h"
+
+namespace ns3
+{
+
+/**
+ * \ingroup wifi
+ * \brief map between the data MAC, the ctrl MAC and the node of a
+ * dual-radio station.
+ *
+ * Every node taking part in the virtual control channel owns one
+ * data MAC (ns3::RegularDataWifiMac) and one ctrl MAC
+ * (ns3::RegularCtrlWifiMac). DataDcaTxop and CtrlDcaTxop need to
+ * translate between these two addresses, and to find the node behind
+ * an address, for every RTS/CTS they relay. A single instance of this
+ * class is meant to be shared by all the txops of a simulation: both
+ * addresses of a node are hashed to the same entry, so that every
+ * lookup is O(1) whatever the number of nodes.
+ */
+class ChannelAddressRegistry: public Object
+{
+public:
+	static TypeId GetTypeId(void);
+
+	ChannelAddressRegistry();
+	virtual ~ChannelAddressRegistry();
+
+	/**
+	 * \param c the set of nodes to register
+	 *
+	 * Call Install (Ptr<Node>) on every node of the container.
+	 */
+	void Install(NodeContainer c);
+	/**
+	 * \param node the node to register
+	 *
+	 * Look for the data and ctrl wifi devices of this node by the
+	 * type of their MAC, whatever their index, and register their
+	 * addresses. Nodes which do not have both kinds of devices are
+	 * ignored. This must be called after the devices are installed.
+	 */
+	void Install(Ptr<Node> node);
+	/**
+	 * \param node the node owning both devices
+	 * \param dataAddr the address of the data MAC of the node
+	 * \param ctrlAddr the address of the ctrl MAC of the node
+	 *
+	 * Register a node. Any previous registration of the node or of
+	 * one of the two addresses is replaced.
+	 */
+	void Add(Ptr<Node> node, Mac48Address dataAddr, Mac48Address ctrlAddr);
+	/**
+	 * \param addr either the data or the ctrl address of a node
+	 *
+	 * Forget the node which owns this address.
+	 */
+	void Remove(Mac48Address addr);
+
+	/**
+	 * \param addr either the data or the ctrl address of a node
+	 * \param node the node which owns this address
+	 * \returns true if the address is known, false otherwise.
+	 */
+	bool FindNode(Mac48Address addr, Ptr<Node> &node) const;
+	/**
+	 * \param addr either the data or the ctrl address of a node
+	 * \param dataAddr the address of the data MAC of the same node
+	 * \returns true if the address is known, false otherwise.
+	 */
+	bool GetDataAddress(Mac48Address addr, Mac48Address &dataAddr) const;
+	/**
+	 * \param addr either the data or the ctrl address of a node
+	 * \param ctrlAddr the address of the ctrl MAC of the same node
+	 * \returns true if the address is known, false otherwise.
+	 */
+	bool GetCtrlAddress(Mac48Address addr, Mac48Address &ctrlAddr) const;
+	/**
+	 * \returns the number of registered nodes.
+	 */
+	uint32_t GetN(void) const;
+
+private:
+	struct Entry
+	{
+		Ptr<Node> node;
+		Mac48Address dataAddr;
+		Mac48Address ctrlAddr;
+	};
+	typedef sgi::hash_map<Mac48Address, Entry *, Mac48AddressHash> Entries;
+	typedef sgi::hash_map<Mac48Address, Entry *, Mac48AddressHash>::iterator EntriesI;
+	typedef sgi::hash_map<Mac48Address, Entry *, Mac48AddressHash>::const_iterator EntriesCI;
+
+	virtual void DoDispose(void);
+	const Entry * Lookup(Mac48Address addr) const;
+	void Flush(void);
+
+	/* both addresses of a node point to the same entry */
+	Entries m_entries;
+	uint32_t m_nNodes;
+};
+
+} // namespace ns3
+
+#endif /* CHANNEL_ADDRESS_REGISTRY_H */
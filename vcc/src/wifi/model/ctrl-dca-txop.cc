@@ -124,7 +124,13 @@ TypeId CtrlDcaTxop::GetTypeId(void)
 			ns3::Dcf::GetTypeId()).AddConstructor<CtrlDcaTxop>().AddAttribute(
 			"Queue", "The WifiMacQueue object", PointerValue(),
 			MakePointerAccessor(&CtrlDcaTxop::GetQueue),
-			MakePointerChecker<WifiMacQueue>());
+			MakePointerChecker<WifiMacQueue>())
+			.AddTraceSource("RtsEnqueued",
+					"An RTS for the data channel is queued for the ctrl channel.",
+					MakeTraceSourceAccessor(&CtrlDcaTxop::m_rtsEnqueuedTrace))
+			.AddTraceSource("ReservationDropped",
+					"An RTS or a CTS is dropped since it can not be sent in time.",
+					MakeTraceSourceAccessor(&CtrlDcaTxop::m_reservationDroppedTrace));
 	return tid;
 }
 
@@ -138,7 +144,7 @@ CtrlDcaTxop::CtrlDcaTxop() :
 	m_rng = new RealRandomStream();
 	m_txMiddle = new MacTxMiddle();
 
-	m_pNodeContainer = 0;
+	m_registry = 0;
 
 	NS_LOG_INFO("This is ctrl DcaTxop");
 }
@@ -162,6 +168,7 @@ void CtrlDcaTxop::DoDispose(void)
 	m_dcf = 0;
 	m_rng = 0;
 	m_txMiddle = 0;
+	m_registry = 0;
 }
 
 void CtrlDcaTxop::SetManager(DcfManager *manager)
@@ -179,6 +186,8 @@ void CtrlDcaTxop::SetLow(Ptr<MacLowCtrl> low)
 			MakeCallback(&CtrlDcaTxop::NotifyDataChannel, this));
 	m_low->SetGetDataChannelStateCallback(
 			MakeCallback(&CtrlDcaTxop::GetDataChannelState, this) );
+	m_low->SetReservationDroppedCallback(
+			MakeCallback(&CtrlDcaTxop::NotifyReservationDropped, this));
 }
 void CtrlDcaTxop::SetWifiRemoteStationManager(
 		Ptr<WifiRemoteStationManager> remoteManager)
@@ -610,20 +619,20 @@ void CtrlDcaTxop::EndTxNoAck(void)
 void CtrlDcaTxop::SendByCtrlChannelImpl(Ptr<const Packet> packet,
 		WifiMacHeader dataHdr)
 {
-	NS_LOG_ERROR( (dataHdr.IsRts() ? "Enqueue an RTS, dst = " : "Enqueue a CTS, dst = ")
+	NS_LOG_DEBUG( (dataHdr.IsRts() ? "Enqueue an RTS, dst = " : "Enqueue a CTS, dst = ")
 			<<dataHdr.GetAddr1()
 			<<", src="<<dataHdr.GetAddr2()
 			<<", duration="<<dataHdr.GetDuration());
 
 	// find corresponding ctrl mac address
-	Ptr<Node> dstNode;
-	Mac48Address ctrlAddr;
-	if (FindNode(dataHdr.GetAddr1(), dstNode))
+	if (m_registry == 0)
 	{
-		ctrlAddr =
-				DynamicCast<WifiNetDevice>(dstNode->GetDevice(1))->GetMac()->GetAddress();
+		NS_LOG_ERROR("m_registry is null");
+		return;
 	}
-	else
+
+	Mac48Address ctrlAddr;
+	if (!m_registry->GetCtrlAddress(dataHdr.GetAddr1(), ctrlAddr))
 	{
 		NS_LOG_ERROR("unknown dest");
 		return;
@@ -647,6 +656,10 @@ void CtrlDcaTxop::SendByCtrlChannelImpl(Ptr<const Packet> packet,
 	}
 
 	Queue(packet, ctrlHdr);
+	if (dataHdr.IsRts())
+	{
+		m_rtsEnqueuedTrace(dataHdr);
+	}
 }
 
 void CtrlDcaTxop::SetNotifyDataChannelCallback(
@@ -656,46 +669,9 @@ void CtrlDcaTxop::SetNotifyDataChannelCallback(
 	m_notifyDataChannelCallback = callback;
 }
 
-void CtrlDcaTxop::SetNodeContainer(NodeContainer *pContainer)
+void CtrlDcaTxop::SetAddressRegistry(Ptr<ChannelAddressRegistry> registry)
 {
-	m_pNodeContainer = pContainer;
-}
-
-bool CtrlDcaTxop::FindNode(Mac48Address addr, Ptr<Node> &node)
-{
-	bool bFound = false;
-
-	if (0 == m_pNodeContainer)
-	{
-		NS_LOG_ERROR("m_pNodeContainer is null");
-		return bFound;
-	}
-
-	Ptr<Node> tmpNode = 0;
-	for (uint32_t i = 0; i < m_pNodeContainer->GetN(); ++i)
-	{
-		tmpNode = m_pNodeContainer->Get(i);
-
-		// NOTE: we assume that index 0 is the ctrl NetDevice,
-		//       while index 1 is the data NetDevice
-		Mac48Address macAddrCtrl = DynamicCast<WifiNetDevice>(
-				tmpNode->GetDevice(0))->GetMac()->GetAddress();
-		Mac48Address macAddrData = DynamicCast<WifiNetDevice>(
-				tmpNode->GetDevice(1))->GetMac()->GetAddress();
-		if (macAddrCtrl == addr || macAddrData == addr)
-		{
-			bFound = true;
-			break;
-		}
-
-	}
-
-	if (bFound)
-	{
-		node = tmpNode;
-	}
-
-	return bFound;
+	m_registry = registry;
 }
 
 void CtrlDcaTxop::NotifyDataChannel(Ptr<Packet> packet, WifiMacHeader hdr)
@@ -707,12 +683,15 @@ void CtrlDcaTxop::NotifyDataChannel(Ptr<Packet> packet, WifiMacHeader hdr)
 	}
 
 	// all the RTS/CTS need to translate addr1 to data address
-	Ptr<Node> targetNode;
+	if (m_registry == 0)
+	{
+		NS_LOG_ERROR("m_registry is null");
+		return;
+	}
+
 	Mac48Address dataAddr;
-	if (FindNode(hdr.GetAddr1(), targetNode))
+	if (m_registry->GetDataAddress(hdr.GetAddr1(), dataAddr))
 	{
-		dataAddr =
-				DynamicCast<WifiNetDevice>(targetNode->GetDevice(0))->GetMac()->GetAddress();
 		hdr.SetAddr1(dataAddr);
 	}
 	else
@@ -723,10 +702,8 @@ void CtrlDcaTxop::NotifyDataChannel(Ptr<Packet> packet, WifiMacHeader hdr)
 
 	if (hdr.IsRts()) // RTS need to translate addr2
 	{
-		if (FindNode(hdr.GetAddr2(), targetNode))
+		if (m_registry->GetDataAddress(hdr.GetAddr2(), dataAddr))
 		{
-			dataAddr =
-					DynamicCast<WifiNetDevice>(targetNode->GetDevice(0))->GetMac()->GetAddress();
 			hdr.SetAddr2(dataAddr);
 		}
 		else
@@ -740,6 +717,18 @@ void CtrlDcaTxop::NotifyDataChannel(Ptr<Packet> packet, WifiMacHeader hdr)
 	m_notifyDataChannelCallback(packet, hdr);
 }
 
+void CtrlDcaTxop::NotifyReservationDropped(const WifiMacHeader &hdr,
+		ReservationDropReason reason)
+{
+	// report the peer by its data address, as the data txop does
+	Mac48Address peer = hdr.GetAddr1();
+	if (m_registry != 0)
+	{
+		m_registry->GetDataAddress(peer, peer);
+	}
+	m_reservationDroppedTrace(peer, reason);
+}
+
 void CtrlDcaTxop::SetGetDataChannelStateCallback(
 		GetDataChannelStaeCallback callback)
 {
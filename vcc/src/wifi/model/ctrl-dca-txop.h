@@ -31,7 +31,9 @@
 #include "ns3/wifi-remote-station-manager.h"
 #include "ns3/dcf.h"
 #include "ns3/mac-low-ctrl.h"
-#include "ns3/node-container.h"
+#include "ns3/channel-address-registry.h"
+#include "ns3/traced-callback.h"
+#include "ns3/reservation-drop-reason.h"
 
 namespace ns3
 {
@@ -194,7 +196,11 @@ public:
 
 	void SetGetDataChannelStateCallback(GetDataChannelStaeCallback callback);
 
-	void SetNodeContainer(NodeContainer *pContainer);
+	/**
+	 * \param registry the data/ctrl address registry shared by all the
+	 * txops of the simulation.
+	 */
+	void SetAddressRegistry(Ptr<ChannelAddressRegistry> registry);
 
 	void NotifyDataChannel(Ptr<Packet> packet, WifiMacHeader hdr);
 
@@ -202,13 +208,18 @@ public:
 				Time & lastTxStart, Time & lastTxDuration, Time & lastNavStart,
 				Time & lastNavDuration);
 
-	bool FindNode(Mac48Address addr, Ptr<Node> &node);
-
 private:
+	void NotifyReservationDropped(const WifiMacHeader &hdr,
+			ReservationDropReason reason);
+
 	NotifyDataChannelCallback m_notifyDataChannelCallback;
 	GetDataChannelStaeCallback m_getDataChannelStateCallback;
 
-	NodeContainer * m_pNodeContainer;
+	Ptr<ChannelAddressRegistry> m_registry;
+
+	/* the headers carry data addresses */
+	TracedCallback<const WifiMacHeader &> m_rtsEnqueuedTrace;
+	TracedCallback<Mac48Address, ReservationDropReason> m_reservationDroppedTrace;
 };
 
 } // namespace ns3
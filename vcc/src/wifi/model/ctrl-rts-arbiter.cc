@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log.h"
+#include "ns3/enum.h"
+#include "ns3/simulator.h"
+#include "ns3/trace-source-accessor.h"
+
+#include "ctrl-rts-arbiter.h"
+
+NS_LOG_COMPONENT_DEFINE("CtrlRtsArbiter");
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED(CtrlRtsArbiter);
+
+TypeId CtrlRtsArbiter::GetTypeId(void)
+{
+	static TypeId tid =
+			TypeId("ns3::CtrlRtsArbiter").SetParent<Object>().AddConstructor<
+					CtrlRtsArbiter>()
+			.AddAttribute("Scope",
+					"The contention domain in which only one RTS is granted per on-air data frame.",
+					EnumValue(CtrlRtsArbiter::PER_TRANSMITTER),
+					MakeEnumAccessor(&CtrlRtsArbiter::m_scope),
+					MakeEnumChecker(CtrlRtsArbiter::GLOBAL, "Global",
+							CtrlRtsArbiter::PER_TRANSMITTER, "PerTransmitter"))
+			.AddTraceSource("Grant",
+					"An RTS is granted during the on-air frame of this transmitter.",
+					MakeTraceSourceAccessor(&CtrlRtsArbiter::m_grantTrace))
+			.AddTraceSource("Deny",
+					"An RTS is denied during the on-air frame of this transmitter.",
+					MakeTraceSourceAccessor(&CtrlRtsArbiter::m_denyTrace));
+	return tid;
+}
+
+CtrlRtsArbiter::CtrlRtsArbiter() :
+		m_scope(PER_TRANSMITTER), m_nGrants(0), m_nDenies(0)
+{
+	NS_LOG_FUNCTION (this);
+}
+
+CtrlRtsArbiter::~CtrlRtsArbiter()
+{
+	NS_LOG_FUNCTION (this);
+}
+
+void CtrlRtsArbiter::DoDispose(void)
+{
+	NS_LOG_FUNCTION (this);
+	m_domains.clear();
+	Object::DoDispose();
+}
+
+bool CtrlRtsArbiter::RequestGrant(Mac48Address onAirSrc, Time onAirEnd)
+{
+	NS_LOG_FUNCTION (this << onAirSrc << onAirEnd);
+
+	// in the global scope, all the frames share the same domain
+	Mac48Address domain =
+			m_scope == GLOBAL ? Mac48Address::GetBroadcast() : onAirSrc;
+
+	Domains::iterator it = m_domains.find(domain);
+	if (it != m_domains.end() && it->second > Simulator::Now())
+	{
+		NS_LOG_DEBUG("deny, domain " << domain << " is locked until " << it->second);
+		++m_nDenies;
+		m_denyTrace(onAirSrc);
+		return false;
+	}
+
+	m_domains[domain] = onAirEnd;
+	++m_nGrants;
+	m_grantTrace(onAirSrc);
+	return true;
+}
+
+uint64_t CtrlRtsArbiter::GetNGrants(void) const
+{
+	return m_nGrants;
+}
+
+uint64_t CtrlRtsArbiter::GetNDenies(void) const
+{
+	return m_nDenies;
+}
+
+void CtrlRtsArbiter::ResetStats(void)
+{
+	m_nGrants = 0;
+	m_nDenies = 0;
+}
+
+} // namespace ns3
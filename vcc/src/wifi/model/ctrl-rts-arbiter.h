@@ -0,0 +1,102 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef CTRL_RTS_ARBITER_H
+#define CTRL_RTS_ARBITER_H
+
+#include <stdint.h>
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/mac48-address.h"
+#include "ns3/sgi-hashmap.h"
+#include "ns3/traced-callback.h"
+
+namespace ns3
+{
+
+/**
+ * \ingroup wifi
+ * \brief decide which station may send an RTS on the ctrl channel
+ * during an on-air data frame.
+ *
+ * While a data frame is on the air, the stations which hear it may
+ * reserve the data channel for their next packet by sending an RTS on
+ * the ctrl channel. Only the first of them is granted this
+ * opportunity, the others are denied until the end of the frame.
+ *
+ * The stations compete in a contention domain. With the default
+ * PerTransmitter scope, a domain is the set of the stations which hear
+ * the same on-air frame, identified by its transmitter: the stations of
+ * non-overlapping cells, hearing different frames, get their
+ * reservations concurrently. With the Global scope, a single domain
+ * covers the whole simulation and only one reservation is allowed at a
+ * time, whatever the frame.
+ *
+ * A single instance is meant to be shared by all the DataDcaTxop of a
+ * simulation.
+ */
+class CtrlRtsArbiter: public Object
+{
+public:
+	enum Scope
+	{
+		GLOBAL, PER_TRANSMITTER
+	};
+
+	static TypeId GetTypeId(void);
+
+	CtrlRtsArbiter();
+	virtual ~CtrlRtsArbiter();
+
+	/**
+	 * \param onAirSrc the transmitter of the on-air data frame
+	 * \param onAirEnd the time at which the on-air frame ends
+	 * \returns true if the caller may send its RTS, false otherwise.
+	 *
+	 * Once granted, the domain of the frame is locked until onAirEnd.
+	 */
+	bool RequestGrant(Mac48Address onAirSrc, Time onAirEnd);
+
+	/**
+	 * \returns the number of granted requests.
+	 */
+	uint64_t GetNGrants(void) const;
+	/**
+	 * \returns the number of denied requests.
+	 */
+	uint64_t GetNDenies(void) const;
+	/**
+	 * Reset the grant and deny counters.
+	 */
+	void ResetStats(void);
+
+private:
+	typedef sgi::hash_map<Mac48Address, Time, Mac48AddressHash> Domains;
+
+	virtual void DoDispose(void);
+
+	enum Scope m_scope;
+	/* the end of the last granted reservation opportunity of each domain */
+	Domains m_domains;
+	uint64_t m_nGrants;
+	uint64_t m_nDenies;
+
+	TracedCallback<Mac48Address> m_grantTrace;
+	TracedCallback<Mac48Address> m_denyTrace;
+};
+
+} // namespace ns3
+
+#endif /* CTRL_RTS_ARBITER_H */
@@ -125,12 +125,30 @@ TypeId DataDcaTxop::GetTypeId(void)
 			ns3::Dcf::GetTypeId()).AddConstructor<DataDcaTxop>().AddAttribute(
 			"Queue", "The WifiMacQueue object", PointerValue(),
 			MakePointerAccessor(&DataDcaTxop::GetQueue),
-			MakePointerChecker<WifiMacQueue>());
+			MakePointerChecker<WifiMacQueue>())
+			.AddAttribute("MaxBurstLength",
+					"The maximum number of packets to the same receiver which a "
+					"single RTS on the ctrl channel may reserve.",
+					UintegerValue(1),
+					MakeUintegerAccessor(&DataDcaTxop::m_maxBurstLength),
+					MakeUintegerChecker<uint32_t>(1))
+			.AddTraceSource("CtsGranted",
+					"A CTS is sent back on the ctrl channel for an RTS to this station, "
+					"with the start of the reserved slot.",
+					MakeTraceSourceAccessor(&DataDcaTxop::m_ctsGrantedTrace))
+			.AddTraceSource("NavScheduled",
+					"A slot of the data channel is reserved for a station, by our own "
+					"CTS or by a CTS heard on the ctrl channel.",
+					MakeTraceSourceAccessor(&DataDcaTxop::m_navScheduledTrace))
+			.AddTraceSource("ReservationDropped",
+					"A reservation of the data channel is given up.",
+					MakeTraceSourceAccessor(&DataDcaTxop::m_reservationDroppedTrace));
 	return tid;
 }
 
 DataDcaTxop::DataDcaTxop() :
-		m_manager(0), m_currentPacket(0)
+		m_manager(0), m_currentPacket(0), m_maxBurstLength(1), m_pendingBurstLength(
+				1), m_burstRemaining(0)
 {
 	NS_LOG_FUNCTION (this);
 	m_transmissionListener = new DataDcaTxop::TransmissionListener(this);
@@ -162,6 +180,8 @@ void DataDcaTxop::DoDispose(void)
 	m_dcf = 0;
 	m_rng = 0;
 	m_txMiddle = 0;
+	m_registry = 0;
+	m_rtsArbiter = 0;
 
 	m_bRequestAccessSucceeded = false;
 }
@@ -559,6 +579,13 @@ void DataDcaTxop::GotAck(double snr, WifiMode txMode)
 		m_dcf->ResetCw();
 		m_dcf->StartBackoffNow(m_rng->GetNext(0, m_dcf->GetCw()));
 		RestartAccessIfNeeded();
+
+		// the NAV set by our own CTS still covers the rest of the burst
+		if (m_burstRemaining > 0)
+		{
+			Simulator::Schedule(m_low->GetSifs(),
+					&DataDcaTxop::SendNextBurstPacket, this);
+		}
 	}
 	else
 	{
@@ -568,6 +595,12 @@ void DataDcaTxop::GotAck(double snr, WifiMode txMode)
 void DataDcaTxop::MissedAck(void)
 {
 	NS_LOG_FUNCTION (this);NS_LOG_DEBUG ("missed ack");
+	if (m_burstRemaining > 0)
+	{
+		NS_LOG_DEBUG("Ack missed, give up the "<<m_burstRemaining<<" packets left in the burst");
+		m_reservationDroppedTrace(m_burstReceiver, RESERVATION_DROP_BURST);
+		m_burstRemaining = 0;
+	}
 	if (!NeedDataRetransmission())
 	{
 		NS_LOG_DEBUG ("Ack Fail");
@@ -658,7 +691,7 @@ void DataDcaTxop::SetSendByCtrlChannleCallback(
 }
 // request ctrl channel to send RTS
 void DataDcaTxop::RequestAccessByCtrlChannel(Ptr<const Packet> packet,
-		const WifiMacHeader &hdr)
+		const WifiMacHeader &hdr, const WifiMacHeader &onAirHdr)
 {
 	if (m_sendByCtrlChannelCallback.IsNull())
 	{
@@ -666,26 +699,30 @@ void DataDcaTxop::RequestAccessByCtrlChannel(Ptr<const Packet> packet,
 		return;
 	}
 
-	if(!(*m_pbGlobalFirstRts))
+	if (m_rtsArbiter == 0)
 	{
-		NS_LOG_ERROR("This is NOT the first Rts in current rxing, cancel it");
+		NS_LOG_ERROR("m_rtsArbiter is null");
 		return;
 	}
 
-	*m_pbGlobalFirstRts = false;
-	// reset global RTS signal after this rxing
-	Time firtRtsResetDelay = m_low->m_myLastRxStart + m_low->m_myLastRxDuration - Simulator::Now();
-	NS_ASSERT(firtRtsResetDelay.IsStrictlyPositive() );
-	Simulator::Cancel(m_firtRtsReset);
-	m_firtRtsReset = Simulator::Schedule(firtRtsResetDelay,
-			&DataDcaTxop::ResetGlobalFirstRts, this);
+	// only the first Rts of the contention domain is allowed during this rxing
+	Time onAirEnd = m_low->m_myLastRxStart + m_low->m_myLastRxDuration;
+	NS_ASSERT(onAirEnd > Simulator::Now());
+	if (!m_rtsArbiter->RequestGrant(onAirHdr.GetAddr2(), onAirEnd))
+	{
+		NS_LOG_DEBUG("This is NOT the first Rts in current rxing, cancel it");
+		m_reservationDroppedTrace(hdr.GetAddr1(), RESERVATION_DROP_ARBITER);
+		return;
+	}
 
-	NS_LOG_ERROR("Prepare to send Rts for next packet, pkt uid="<< packet->GetUid() );
-	// prepare RTS
+	NS_LOG_DEBUG("Prepare to send Rts for next packet, pkt uid="<< packet->GetUid() );
+	// prepare RTS, it reserves the following packets to the same receiver too
 	Time delay;
 	Ptr<Packet> rtsPacket = Create<Packet>();
 	WifiMacHeader rtsHdr;
 	m_low->SetupRtsForDataPacket(packet, hdr, rtsPacket, rtsHdr, &delay);
+	m_pendingBurstLength = 1 + ReserveBurst(hdr, rtsHdr);
+	m_burstReceiver = hdr.GetAddr1();
 
 	m_sendByCtrlChannelCallback(rtsPacket, rtsHdr);
 
@@ -715,7 +752,7 @@ void DataDcaTxop::NotifyDataChannelImpl(Ptr<Packet> packet, WifiMacHeader hdr)
 {
 	if (hdr.IsRts() && hdr.GetAddr1() == m_low->m_self) // RTS for me
 	{
-		NS_LOG_ERROR("Data Channel Got RTS: dst=" <<hdr.GetAddr1()
+		NS_LOG_DEBUG("Data Channel Got RTS: dst=" <<hdr.GetAddr1()
 				<<", src="<<hdr.GetAddr2()
 				<<", duration="<<hdr.GetDuration() );
 
@@ -724,6 +761,12 @@ void DataDcaTxop::NotifyDataChannelImpl(Ptr<Packet> packet, WifiMacHeader hdr)
 		WifiMacHeader ctsHdr;
 		m_low->SetupCtsForRts(packet, hdr, ctsPacket, ctsHdr);
 
+		uint64_t startTime;
+		ctsPacket->CopyData((uint8_t *) (&startTime), sizeof(uint64_t));
+		Time start(startTime);
+		m_ctsGrantedTrace(ctsHdr, start);
+		m_navScheduledTrace(ctsHdr.GetAddr1(), start, ctsHdr.GetDuration());
+
 		// send CTS by ctrl channel
 		if (!m_sendByCtrlChannelCallback.IsNull())
 		{
@@ -739,13 +782,22 @@ void DataDcaTxop::NotifyDataChannelImpl(Ptr<Packet> packet, WifiMacHeader hdr)
 	{
 		if (!m_low->IsValidCts(packet, hdr))
 		{
-			NS_LOG_ERROR("Invalid Cts, drop it.");
+			NS_LOG_DEBUG("Invalid Cts, drop it.");
+			m_reservationDroppedTrace(
+					hdr.GetAddr1() == m_low->m_self ?
+							m_burstReceiver : hdr.GetAddr1(),
+					RESERVATION_DROP_INVALID_CTS);
 			return;
 		}
 
 		// give all CTS to MacLow to update its NAV
 		m_low->GotCtsPacket(packet, hdr);
 
+		uint64_t startTime;
+		packet->CopyData((uint8_t *) (&startTime), sizeof(uint64_t));
+		Time start(startTime);
+		m_navScheduledTrace(hdr.GetAddr1(), start, hdr.GetDuration());
+
 		if (hdr.GetAddr1() == m_low->m_self) // CTS for me
 		{
 //			// cancel CTS timeout event
@@ -754,31 +806,22 @@ void DataDcaTxop::NotifyDataChannelImpl(Ptr<Packet> packet, WifiMacHeader hdr)
 			m_bRequestAccessSucceeded = true;
 
 			// send data according CTS
-			uint64_t startTime;
-			packet->CopyData((uint8_t *) (&startTime), sizeof(uint64_t));
-			Time start(startTime);
-
 			// NOTE: here we have to wait for a SIFS before sending data!
 			Time delay = start + m_low->GetSifs() - Simulator::Now();
 			NS_ASSERT(delay.IsStrictlyPositive());
 
 			EventId sendPacketId = Simulator::Schedule(delay,
 					&DataDcaTxop::SendPacketAsScheduled, this);
-			NS_LOG_ERROR("prepare to send data after CTS, delay = " << delay
+			NS_LOG_DEBUG("prepare to send data after CTS, delay = " << delay
 					<<", EventId = "<<sendPacketId.GetUid());
 
 		}
 	}
 }
 
-void DataDcaTxop::SetGlobalRtsSignal(bool *pGlobalSignal)
+void DataDcaTxop::SetRtsArbiter(Ptr<CtrlRtsArbiter> arbiter)
 {
-	m_pbGlobalFirstRts = pGlobalSignal;
-}
-
-void DataDcaTxop::ResetGlobalFirstRts()
-{
-	*m_pbGlobalFirstRts = true;
+	m_rtsArbiter = arbiter;
 }
 
 void DataDcaTxop::SendPacketAsScheduled()
@@ -787,13 +830,21 @@ void DataDcaTxop::SendPacketAsScheduled()
 
 	if (m_currentPacket == 0)
 	{
-		if (m_queue->IsEmpty())
+		// the RTS and the burst were sized for the packets to this receiver
+		m_currentPacket = m_queue->DequeueByAddress(&m_currentHdr,
+				WifiMacHeader::ADDR1, m_burstReceiver);
+		if (m_currentPacket == 0)
 		{
-			NS_LOG_DEBUG ("queue empty");
+			NS_LOG_DEBUG ("no packet for "<<m_burstReceiver<<", give up the reservation");
+			if (m_pendingBurstLength > 1)
+			{
+				m_reservationDroppedTrace(m_burstReceiver, RESERVATION_DROP_BURST);
+			}
+			// the packets to the other receivers go through the DCF
+			m_bRequestAccessSucceeded = false;
+			RestartAccessIfNeeded();
 			return;
 		}
-		m_currentPacket = m_queue->Dequeue(&m_currentHdr);
-		NS_ASSERT(m_currentPacket != 0);
 		uint16_t sequence = m_txMiddle->GetNextSequenceNumberfor(&m_currentHdr);
 		m_currentHdr.SetSequenceNumber(sequence);
 		m_currentHdr.SetFragmentNumber(0);
@@ -805,7 +856,28 @@ void DataDcaTxop::SendPacketAsScheduled()
 				", seq=" << m_currentHdr.GetSequenceControl ());
 	}
 
-	NS_LOG_ERROR("Sending Data af. Cts, uid="<<m_currentPacket->GetUid()
+	if (m_currentHdr.GetAddr1() == m_burstReceiver)
+	{
+		m_burstRemaining = m_pendingBurstLength - 1;
+	}
+	else
+	{
+		// a retransmission to another receiver takes the slot, the NAV
+		// does not cover a burst after it
+		m_burstRemaining = 0;
+		if (m_pendingBurstLength > 1)
+		{
+			NS_LOG_DEBUG("Sending to "<<m_currentHdr.GetAddr1()
+					<<", give up the burst to "<<m_burstReceiver);
+			m_reservationDroppedTrace(m_burstReceiver, RESERVATION_DROP_BURST);
+		}
+	}
+	SendReservedPacket();
+}
+
+void DataDcaTxop::SendReservedPacket()
+{
+	NS_LOG_DEBUG("Sending Data af. Cts, uid="<<m_currentPacket->GetUid()
 			<<", size = "<< m_currentPacket->GetSize()
 			<<", dst = "<< m_currentHdr.GetAddr1()
 			<<", src = "<< m_currentHdr.GetAddr2()
@@ -867,8 +939,45 @@ void DataDcaTxop::SendPacketAsScheduled()
 
 }
 
+void DataDcaTxop::SendNextBurstPacket()
+{
+	if (m_burstRemaining == 0)
+	{
+		return;
+	}
+	if (m_currentPacket != 0)
+	{
+		NS_LOG_DEBUG("A packet is pending, give up the "<<m_burstRemaining
+				<<" packets left in the burst");
+		m_reservationDroppedTrace(m_burstReceiver, RESERVATION_DROP_BURST);
+		m_burstRemaining = 0;
+		return;
+	}
+	--m_burstRemaining;
+
+	// the reservation was made for this receiver only
+	m_currentPacket = m_queue->DequeueByAddress(&m_currentHdr,
+			WifiMacHeader::ADDR1, m_burstReceiver);
+	if (m_currentPacket == 0)
+	{
+		NS_LOG_DEBUG("No more packet for "<<m_burstReceiver
+				<<", give up the rest of the burst");
+		m_reservationDroppedTrace(m_burstReceiver, RESERVATION_DROP_BURST);
+		m_burstRemaining = 0;
+		return;
+	}
+	uint16_t sequence = m_txMiddle->GetNextSequenceNumberfor(&m_currentHdr);
+	m_currentHdr.SetSequenceNumber(sequence);
+	m_currentHdr.SetFragmentNumber(0);
+	m_currentHdr.SetNoMoreFragments();
+	m_currentHdr.SetNoRetry();
+	m_fragmentNumber = 0;
+
+	SendReservedPacket();
+}
+
 // someone is transmitting
-void DataDcaTxop::NotifyRxStart(Time rxDuration, WifiMacHeader hdr, Ptr<const Packet> packet)
+void DataDcaTxop::NotifyRxStart(Time rxDuration, const WifiMacHeader &hdr, Ptr<const Packet> packet)
 {
 	// the current on-air packet is data and long enough, send an Rts
 	// on ctrl channel if needed
@@ -886,13 +995,13 @@ void DataDcaTxop::NotifyRxStart(Time rxDuration, WifiMacHeader hdr, Ptr<const Pa
 
 }
 
-void DataDcaTxop::NotifyTxStart(Time duration, WifiMacHeader hdr)
+void DataDcaTxop::NotifyTxStart(Time duration, const WifiMacHeader &hdr)
 {
 	// We do not consider a node transmits data and control simultaneously
 	// so, we don't do anything here
 	if (hdr.IsData() && duration > Time(180000))
 	{
-		NS_LOG_ERROR("start Tx data, src="<<hdr.GetAddr2()
+		NS_LOG_DEBUG("start Tx data, src="<<hdr.GetAddr2()
 				<< ", dst="<<hdr.GetAddr1()
 				<<", duration="<<duration);
 	}
@@ -908,6 +1017,13 @@ void DataDcaTxop::SendRtsOnCtrlChannelIfNeeded(Time duration,
 		return;
 	}
 
+	// the granted reservation will carry the head of the queue
+	if (m_bRequestAccessSucceeded || m_burstRemaining > 0)
+	{
+		NS_LOG_INFO("do NOT need Rts since a reservation is pending.");
+		return;
+	}
+
 	WifiMacHeader nextHdr;
 	Ptr<const Packet> nextPacket = m_queue->Peek(&nextHdr);
 
@@ -917,7 +1033,7 @@ void DataDcaTxop::SendRtsOnCtrlChannelIfNeeded(Time duration,
 					onAirHdr.GetAddr1(), onAirHdr.GetAddr2() )
 		)
 	{
-		RequestAccessByCtrlChannel(nextPacket, nextHdr);
+		RequestAccessByCtrlChannel(nextPacket, nextHdr, onAirHdr);
 	}
 	else
 	{
@@ -929,46 +1045,58 @@ void DataDcaTxop::SendRtsOnCtrlChannelIfNeeded(Time duration,
 
 }
 
-bool DataDcaTxop::FindNode(Mac48Address addr, Ptr<Node> &node)
+uint32_t DataDcaTxop::ReserveBurst(const WifiMacHeader &hdr,
+		WifiMacHeader &rtsHdr)
 {
-	bool bFound = false;
-
-	if (0 == m_pNodeContainer)
+	if (m_maxBurstLength <= 1)
 	{
-		NS_LOG_ERROR("m_pNodeContainer is null");
-		return bFound;
+		return 0;
 	}
 
-	Ptr<Node> tmpNode = 0;
-	for (uint32_t i = 0; i < m_pNodeContainer->GetN(); ++i)
+	std::vector<Ptr<const Packet> > packets;
+	std::vector<WifiMacHeader> hdrs;
+	m_queue->PeekByAddress(packets, hdrs, WifiMacHeader::ADDR1,
+			hdr.GetAddr1(), m_maxBurstLength);
+
+	// the first packet is the one the RTS has been set up for
+	uint32_t n = 0;
+	for (uint32_t i = 1; i < packets.size(); ++i)
 	{
-		tmpNode = m_pNodeContainer->Get(i);
-
-		// NOTE: we assume that index 0 is the ctrl NetDevice,
-		//       while index 1 is the data NetDevice
-		Mac48Address macAddrCtrl = DynamicCast<WifiNetDevice>(
-				tmpNode->GetDevice(0))->GetMac()->GetAddress();
-		Mac48Address macAddrData = DynamicCast<WifiNetDevice>(
-				tmpNode->GetDevice(1))->GetMac()->GetAddress();
-		if (macAddrCtrl == addr || macAddrData == addr)
+		if (!hdrs[i].IsData()
+				|| m_stationManager->NeedFragmentation(hdrs[i].GetAddr1(),
+						&hdrs[i], packets[i]))
 		{
-			bFound = true;
 			break;
 		}
+		if (!m_low->ExtendRtsForDataPacket(packets[i], hdrs[i], rtsHdr))
+		{
+			break;
+		}
+		++n;
+	}
 
+	if (n > 0)
+	{
+		NS_LOG_DEBUG("Rts reserves a burst of "<<(n + 1)<<" packets to "
+				<<hdr.GetAddr1()<<", duration="<<rtsHdr.GetDuration());
 	}
+	return n;
+}
 
-	if (bFound)
+bool DataDcaTxop::FindNode(Mac48Address addr, Ptr<Node> &node)
+{
+	if (m_registry == 0)
 	{
-		node = tmpNode;
+		NS_LOG_ERROR("m_registry is null");
+		return false;
 	}
 
-	return bFound;
+	return m_registry->FindNode(addr, node);
 }
 
-void DataDcaTxop::SetNodeContainer(NodeContainer *pContainer)
+void DataDcaTxop::SetAddressRegistry(Ptr<ChannelAddressRegistry> registry)
 {
-	m_pNodeContainer = pContainer;
+	m_registry = registry;
 }
 
 double DataDcaTxop::CalculateDistance(Ptr<Node> node1, Ptr<Node> node2)
@@ -998,13 +1126,13 @@ bool DataDcaTxop::IsEnoughForCtrlRts(Mac48Address rtsDst, Mac48Address rtsSrc,
 {
 	if (rtsDst == onAirDst)		// condition 1
 	{
-		NS_LOG_ERROR("do not allow Rts with dst == onAirDst");
+		NS_LOG_DEBUG("do not allow Rts with dst == onAirDst");
 		return false;
 	}
 
 	if (rtsDst == onAirSrc)		// condition 1
 	{
-		NS_LOG_ERROR("do not allow Rts with dst == onAirSrc");
+		NS_LOG_DEBUG("do not allow Rts with dst == onAirSrc");
 		return false;
 	}
 
@@ -1029,7 +1157,7 @@ bool DataDcaTxop::IsEnoughForCtrlRts(Mac48Address rtsDst, Mac48Address rtsSrc,
 	}
 	else
 	{
-		NS_LOG_ERROR("Too close to send Rts");
+		NS_LOG_DEBUG("Too close to send Rts");
 		return false;
 	}
 
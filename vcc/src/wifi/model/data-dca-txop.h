@@ -31,7 +31,11 @@
 #include "ns3/wifi-remote-station-manager.h"
 #include "ns3/dcf.h"
 #include "ns3/mac-low-data.h"
-#include "ns3/node-container.h"
+#include "ns3/node.h"
+#include "ns3/channel-address-registry.h"
+#include "ns3/ctrl-rts-arbiter.h"
+#include "ns3/traced-callback.h"
+#include "ns3/reservation-drop-reason.h"
 
 namespace ns3 {
 
@@ -129,6 +133,7 @@ private:
   class Dcf;
   friend class Dcf;
   friend class TransmissionListener;
+  friend class DataDcaTxopBurstTest;
 
   DataDcaTxop &operator = (const DataDcaTxop &);
   DataDcaTxop (const DataDcaTxop &o);
@@ -191,28 +196,58 @@ public:
 
   void SetSendByCtrlChannleCallback(SendByCtrlChannelCallback callback);
 
-  void SetGlobalRtsSignal(bool *pGlobalSignal);
+  /**
+   * \param arbiter the arbiter deciding which station may send an RTS
+   * on the ctrl channel, shared by all the txops of the simulation.
+   */
+  void SetRtsArbiter(Ptr<CtrlRtsArbiter> arbiter);
 
-  void RequestAccessByCtrlChannel(Ptr<const Packet> packet, const WifiMacHeader &hdr);
+  void RequestAccessByCtrlChannel(Ptr<const Packet> packet, const WifiMacHeader &hdr,
+		  const WifiMacHeader &onAirHdr);
 
   void CtrlRtsTimeout();
 
-  void ResetGlobalFirstRts();
-
   void SendPacketAsScheduled();
 
-  void NotifyRxStart(Time rxDuration, WifiMacHeader hdr, Ptr<const Packet> packet);
+  /**
+   * Send the next packet of the burst reserved by the last CTS, a SIFS
+   * after the ACK of the previous one.
+   */
+  void SendNextBurstPacket();
 
-  void NotifyTxStart(Time duration, WifiMacHeader hdr);
+  void NotifyRxStart(Time rxDuration, const WifiMacHeader &hdr, Ptr<const Packet> packet);
+
+  void NotifyTxStart(Time duration, const WifiMacHeader &hdr);
 
   void SendRtsOnCtrlChannelIfNeeded(Time duration, WifiMacHeader onAirHdr);
 
   bool FindNode(Mac48Address addr, Ptr<Node> &node);
 
-  void SetNodeContainer(NodeContainer *pContainer);
+  /**
+   * \param registry the data/ctrl address registry shared by all the
+   * txops of the simulation.
+   */
+  void SetAddressRegistry(Ptr<ChannelAddressRegistry> registry);
 
   double CalculateDistance(Ptr<Node> node1, Ptr<Node> node2);
 
+  /**
+   * \param hdr the header of the packet an RTS has been set up for
+   * \param rtsHdr the header of this RTS
+   * \returns the number of packets which follow this one in the burst
+   * reserved by the RTS.
+   *
+   * Extend the RTS duration to the packets queued for the same
+   * receiver, up to MaxBurstLength packets in all.
+   */
+  uint32_t ReserveBurst(const WifiMacHeader &hdr, WifiMacHeader &rtsHdr);
+
+  /**
+   * Send the current packet in a slot reserved by a CTS, the DCF is
+   * bypassed.
+   */
+  void SendReservedPacket();
+
   bool IsEnoughForCtrlRts(Mac48Address rtsDst, Mac48Address rtsSrc, Mac48Address onAirDst, Mac48Address onAirSrc);
 
   void GetDataChannelStateImpl(Time & lastRxStart, Time & lastRxDuration,
@@ -223,11 +258,21 @@ private:
   SendByCtrlChannelCallback m_sendByCtrlChannelCallback;
   bool m_bRequestAccessSucceeded;
   EventId m_ctrlRtsTimeout;
-  EventId m_firtRtsReset;
-  bool *m_pbGlobalFirstRts;
+  Ptr<CtrlRtsArbiter> m_rtsArbiter;
   uint16_t m_packetID;
 
-  NodeContainer * m_pNodeContainer;
+  Ptr<ChannelAddressRegistry> m_registry;
+
+  uint32_t m_maxBurstLength;
+  /* number of packets reserved by the last RTS */
+  uint32_t m_pendingBurstLength;
+  /* number of reserved packets which are not sent yet */
+  uint32_t m_burstRemaining;
+  Mac48Address m_burstReceiver;
+
+  TracedCallback<const WifiMacHeader &, Time> m_ctsGrantedTrace;
+  TracedCallback<Mac48Address, Time, Time> m_navScheduledTrace;
+  TracedCallback<Mac48Address, ReservationDropReason> m_reservationDroppedTrace;
 
 public:
   uint32_t m_enqueueCount;
@@ -219,7 +219,7 @@ public:
   virtual ~PhyListener ()
   {
   }
-  virtual void NotifyRxStart (Time rxDuration, WifiMacHeader hdr, Ptr<const Packet> packet)
+  virtual void NotifyRxStart (Time rxDuration, const WifiMacHeader &hdr, Ptr<const Packet> packet)
   {
     m_dcf->NotifyRxStartNow (rxDuration);
   }
@@ -231,7 +231,7 @@ public:
   {
     m_dcf->NotifyRxEndErrorNow ();
   }
-  virtual void NotifyTxStart (Time duration, WifiMacHeader hdr)
+  virtual void NotifyTxStart (Time duration, const WifiMacHeader &hdr)
   {
     m_dcf->NotifyTxStartNow (duration);
   }
@@ -420,54 +420,56 @@ DcfManager::RequestAccess (DcfState *state)
 void
 DcfManager::DoGrantAccess (void)
 {
+  Time accessGrantStart = GetAccessGrantStart ();
+  DcfState *grantedState = 0;
+  std::vector<DcfState *> internalCollisionStates;
   uint32_t k = 0;
-  for (States::const_iterator i = m_states.begin (); i != m_states.end (); k++)
+  for (States::const_iterator i = m_states.begin (); i != m_states.end (); i++, k++)
     {
       DcfState *state = *i;
-      if (state->IsAccessRequested ()
-          && GetBackoffEndFor (state) <= Simulator::Now () )
+      if (!state->IsAccessRequested ()
+          || GetBackoffEndFor (state, accessGrantStart) > Simulator::Now ())
+        {
+          continue;
+        }
+      if (grantedState == 0)
         {
           /**
            * This is the first dcf we find with an expired backoff and which
            * needs access to the medium. i.e., it has data to send.
            */
           MY_DEBUG ("dcf " << k << " needs access. backoff expired. access granted. slots=" << state->GetBackoffSlots ());
-          i++; // go to the next item in the list.
-          k++;
-          std::vector<DcfState *> internalCollisionStates;
-          for (States::const_iterator j = i; j != m_states.end (); j++, k++)
-            {
-              DcfState *otherState = *j;
-              if (otherState->IsAccessRequested ()
-                  && GetBackoffEndFor (otherState) <= Simulator::Now ())
-                {
-                  MY_DEBUG ("dcf " << k << " needs access. backoff expired. internal collision. slots=" <<
-                            otherState->GetBackoffSlots ());
-                  /**
-                   * all other dcfs with a lower priority whose backoff
-                   * has expired and which needed access to the medium
-                   * must be notified that we did get an internal collision.
-                   */
-                  internalCollisionStates.push_back (otherState);
-                }
-            }
-
+          grantedState = state;
+        }
+      else
+        {
+          MY_DEBUG ("dcf " << k << " needs access. backoff expired. internal collision. slots=" <<
+                    state->GetBackoffSlots ());
           /**
-           * Now, we notify all of these changes in one go. It is necessary to
-           * perform first the calculations of which states are colliding and then
-           * only apply the changes because applying the changes through notification
-           * could change the global state of the manager, and, thus, could change
-           * the result of the calculations.
+           * all other dcfs with a lower priority whose backoff
+           * has expired and which needed access to the medium
+           * must be notified that we did get an internal collision.
            */
-          state->NotifyAccessGranted ();
-          for (std::vector<DcfState *>::const_iterator k = internalCollisionStates.begin ();
-               k != internalCollisionStates.end (); k++)
-            {
-              (*k)->NotifyInternalCollision ();
-            }
-          break;
+          internalCollisionStates.push_back (state);
         }
-      i++;
+    }
+  if (grantedState == 0)
+    {
+      return;
+    }
+
+  /**
+   * Now, we notify all of these changes in one go. It is necessary to
+   * perform first the calculations of which states are colliding and then
+   * only apply the changes because applying the changes through notification
+   * could change the global state of the manager, and, thus, could change
+   * the result of the calculations.
+   */
+  grantedState->NotifyAccessGranted ();
+  for (std::vector<DcfState *>::const_iterator j = internalCollisionStates.begin ();
+       j != internalCollisionStates.end (); j++)
+    {
+      (*j)->NotifyInternalCollision ();
     }
 }
 
@@ -518,29 +520,41 @@ DcfManager::GetAccessGrantStart (void) const
 }
 
 Time
-DcfManager::GetBackoffStartFor (DcfState *state)
+DcfManager::GetBackoffStartFor (DcfState *state, Time accessGrantStart) const
 {
   Time mostRecentEvent = MostRecent (state->GetBackoffStart (),
-                                     GetAccessGrantStart () + MicroSeconds (state->GetAifsn () * m_slotTimeUs));
+                                     accessGrantStart + MicroSeconds (state->GetAifsn () * m_slotTimeUs));
 
   return mostRecentEvent;
 }
 
 Time
-DcfManager::GetBackoffEndFor (DcfState *state)
+DcfManager::GetBackoffEndFor (DcfState *state, Time accessGrantStart) const
 {
-  return GetBackoffStartFor (state) + MicroSeconds (state->GetBackoffSlots () * m_slotTimeUs);
+  return GetBackoffStartFor (state, accessGrantStart) + MicroSeconds (state->GetBackoffSlots () * m_slotTimeUs);
 }
 
 void
 DcfManager::UpdateBackoff (void)
 {
+  Time accessGrantStart = GetAccessGrantStart ();
   uint32_t k = 0;
   for (States::const_iterator i = m_states.begin (); i != m_states.end (); i++, k++)
     {
       DcfState *state = *i;
+      /**
+       * A state without backoff and which does not need access would only
+       * move its backoff start up to the access grant start. Once in the
+       * past, the access grant start never goes back, so that
+       * GetBackoffStartFor returns the same value whether the state is
+       * updated now or not.
+       */
+      if (!state->IsAccessRequested () && state->GetBackoffSlots () == 0)
+        {
+          continue;
+        }
 
-      Time backoffStart = GetBackoffStartFor (state);
+      Time backoffStart = GetBackoffStartFor (state, accessGrantStart);
       if (backoffStart <= Simulator::Now ())
         {
           uint32_t nus = (Simulator::Now () - backoffStart).GetMicroSeconds ();
@@ -562,12 +576,13 @@ DcfManager::DoRestartAccessTimeoutIfNeeded (void)
    */
   bool accessTimeoutNeeded = false;
   Time expectedBackoffEnd = Simulator::GetMaximumSimulationTime ();
+  Time accessGrantStart = GetAccessGrantStart ();
   for (States::const_iterator i = m_states.begin (); i != m_states.end (); i++)
     {
       DcfState *state = *i;
       if (state->IsAccessRequested ())
         {
-          Time tmp = GetBackoffEndFor (state);
+          Time tmp = GetBackoffEndFor (state, accessGrantStart);
           if (tmp > Simulator::Now ())
             {
               accessTimeoutNeeded = true;
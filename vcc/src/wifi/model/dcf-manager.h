@@ -300,8 +300,13 @@ private:
    * be granted
    */
   Time GetAccessGrantStart (void) const;
-  Time GetBackoffStartFor (DcfState *state);
-  Time GetBackoffEndFor (DcfState *state);
+  /**
+   * \param state a DcfState
+   * \param accessGrantStart the value returned by GetAccessGrantStart,
+   *        which is the same for all the states of a pass.
+   */
+  Time GetBackoffStartFor (DcfState *state, Time accessGrantStart) const;
+  Time GetBackoffEndFor (DcfState *state, Time accessGrantStart) const;
   void DoRestartAccessTimeoutIfNeeded (void);
   void AccessTimeout (void);
   void DoGrantAccess (void);
@@ -115,7 +115,10 @@ InterferenceHelper::NiChange::operator < (const InterferenceHelper::NiChange& o)
 
 InterferenceHelper::InterferenceHelper ()
   : m_errorRateModel (0),
+    m_head (0),
     m_firstPower (0.0),
+    m_cursor (0),
+    m_cursorPower (0.0),
     m_rxing (false)
 {
 }
@@ -170,17 +173,19 @@ Time
 InterferenceHelper::GetEnergyDuration (double energyW)
 {
   Time now = Simulator::Now ();
-  double noiseInterferenceW = 0.0;
+  // the nichanges in the past are summed once and for all: nothing is
+  // ever inserted before them.
+  while (m_cursor < m_niChanges.size () && m_niChanges[m_cursor].GetTime () < now)
+    {
+      m_cursorPower += m_niChanges[m_cursor].GetDelta ();
+      m_cursor++;
+    }
+  double noiseInterferenceW = m_cursorPower;
   Time end = now;
-  noiseInterferenceW = m_firstPower;
-  for (NiChanges::const_iterator i = m_niChanges.begin (); i != m_niChanges.end (); i++)
+  for (NiChanges::const_iterator i = m_niChanges.begin () + m_cursor; i != m_niChanges.end (); i++)
     {
       noiseInterferenceW += i->GetDelta ();
       end = i->GetTime ();
-      if (end < now)
-        {
-          continue;
-        }
       if (noiseInterferenceW < energyW)
         {
           break;
@@ -192,23 +197,13 @@ InterferenceHelper::GetEnergyDuration (double energyW)
 void
 InterferenceHelper::AppendEvent (Ptr<InterferenceHelper::Event> event)
 {
-  Time now = Simulator::Now ();
   if (!m_rxing)
     {
-      NiChanges::iterator nowIterator = GetPosition (now);
-      for (NiChanges::iterator i = m_niChanges.begin (); i != nowIterator; i++)
-        {
-          m_firstPower += i->GetDelta ();
-        }
-      m_niChanges.erase (m_niChanges.begin (), nowIterator);
-      m_niChanges.insert (m_niChanges.begin (), NiChange (event->GetStartTime (), event->GetRxPowerW ()));
-    }
-  else
-    {
-      AddNiChangeEvent (NiChange (event->GetStartTime (), event->GetRxPowerW ()));
+      // the start of the event becomes the first nichange
+      FoldNiChanges (Simulator::Now ());
     }
+  AddNiChangeEvent (NiChange (event->GetStartTime (), event->GetRxPowerW ()));
   AddNiChangeEvent (NiChange (event->GetEndTime (), -event->GetRxPowerW ()));
-
 }
 
 
@@ -231,7 +226,10 @@ InterferenceHelper::CalculateNoiseInterferenceW (Ptr<InterferenceHelper::Event>
 {
   double noiseInterference = m_firstPower;
   NS_ASSERT (m_rxing);
-  for (NiChanges::const_iterator i = m_niChanges.begin () + 1; i != m_niChanges.end (); i++)
+  NS_ASSERT (m_head < m_niChanges.size ());
+  ni->reserve (m_niChanges.size () - m_head + 1);
+  ni->push_back (NiChange (event->GetStartTime (), noiseInterference));
+  for (NiChanges::const_iterator i = m_niChanges.begin () + m_head + 1; i != m_niChanges.end (); i++)
     {
       if ((event->GetEndTime () == i->GetTime ()) && event->GetRxPowerW () == -i->GetDelta ())
         {
@@ -239,7 +237,6 @@ InterferenceHelper::CalculateNoiseInterferenceW (Ptr<InterferenceHelper::Event>
         }
       ni->push_back (*i);
     }
-  ni->insert (ni->begin (), NiChange (event->GetStartTime (), noiseInterference));
   ni->push_back (NiChange (event->GetEndTime (), 0));
   return noiseInterference;
 }
@@ -370,13 +367,16 @@ InterferenceHelper::EraseEvents (void)
 {
   m_niChanges.clear ();
   m_rxing = false;
+  m_head = 0;
   m_firstPower = 0.0;
+  m_cursor = 0;
+  m_cursorPower = 0.0;
 }
 InterferenceHelper::NiChanges::iterator
 InterferenceHelper::GetPosition (Time moment)
 {
-  return std::upper_bound (m_niChanges.begin (), m_niChanges.end (), NiChange (moment, 0));
-
+  // nothing is ever added before the cursor
+  return std::upper_bound (m_niChanges.begin () + m_cursor, m_niChanges.end (), NiChange (moment, 0));
 }
 void
 InterferenceHelper::AddNiChangeEvent (NiChange change)
@@ -384,6 +384,26 @@ InterferenceHelper::AddNiChangeEvent (NiChange change)
   m_niChanges.insert (GetPosition (change.GetTime ()), change);
 }
 void
+InterferenceHelper::FoldNiChanges (Time moment)
+{
+  NS_ASSERT (m_head <= m_cursor);
+  // resume from the cursor so that the deltas are summed in the same order
+  NiChanges::iterator end = GetPosition (moment);
+  double power = m_cursorPower;
+  for (NiChanges::iterator i = m_niChanges.begin () + m_cursor; i != end; i++)
+    {
+      power += i->GetDelta ();
+    }
+  m_head = m_cursor = end - m_niChanges.begin ();
+  m_firstPower = m_cursorPower = power;
+  // the folded nichanges are dropped once they fill half of the vector
+  if (m_head * 2 >= m_niChanges.size ())
+    {
+      m_niChanges.erase (m_niChanges.begin (), end);
+      m_head = m_cursor = 0;
+    }
+}
+void
 InterferenceHelper::NotifyRxStart ()
 {
   m_rxing = true;
@@ -123,11 +123,19 @@ private:
   Ptr<ErrorRateModel> m_errorRateModel;
   /// Experimental: needed for energy duration calculation
   NiChanges m_niChanges;
+  /// Index of the first nichange which is not yet folded into m_firstPower
+  uint32_t m_head;
   double m_firstPower;
+  /// Index of the first nichange which is not yet folded into m_cursorPower
+  uint32_t m_cursor;
+  /// m_firstPower plus the deltas of the nichanges in [m_head, m_cursor)
+  double m_cursorPower;
   bool m_rxing;
   /// Returns an iterator to the first nichange, which is later than moment
   NiChanges::iterator GetPosition (Time moment);
   void AddNiChangeEvent (NiChange change);
+  /// Folds the nichanges which are not later than moment into m_firstPower
+  void FoldNiChanges (Time moment);
 };
 
 } // namespace ns3
@@ -111,7 +111,7 @@ void MacLowCtrl::SendRtsPacket()
 
 	//check whether is enough to send RTS
 	Time ctsDuration = GetCtsDuration(m_currentHdr.GetAddr1(), rtsTxMode);
-	Time rtsDuration = m_phy->CalculateTxDuration(GetCtsSize(), rtsTxMode,
+	Time rtsDuration = m_phy->GetTxDuration(GetCtsSize(), rtsTxMode,
 			WIFI_PREAMBLE_LONG);
 	Time possibleDuration = rtsDuration + GetSifs() + ctsDuration;
 
@@ -128,12 +128,16 @@ void MacLowCtrl::SendRtsPacket()
 	Time possibleEnd = Simulator::Now() + possibleDuration + NanoSeconds(30); // consider the delay of function invoke delay
 	if (possibleEnd >= dataRxStart + dataRxDuration)
 	{
-		NS_LOG_ERROR("It is NOT enough to send a Rts from now, drop it.");
+		NS_LOG_DEBUG("It is NOT enough to send a Rts from now, drop it.");
+		if (!m_reservationDroppedCallback.IsNull())
+		{
+			m_reservationDroppedCallback(m_currentHdr, RESERVATION_DROP_LATE_RTS);
+		}
 		m_currentPacket = 0;
 		return;
 	}
 
-	NS_LOG_ERROR("Sending Rts, dst="<<m_currentHdr.GetAddr1()
+	NS_LOG_DEBUG("Sending Rts, dst="<<m_currentHdr.GetAddr1()
 			<<", src="<<m_currentHdr.GetAddr2());
 	ForwardDown(m_currentPacket, &m_currentHdr, rtsTxMode);
 	m_currentPacket = 0;
@@ -171,12 +175,16 @@ void MacLowCtrl::SendCtsPacket()
 	Time possibleEnd = Simulator::Now() + ctsDuration + NanoSeconds(30); // consider the delay of function invoke delay
 	if (possibleEnd >= dataRxStart + dataRxDuration)
 	{
-		NS_LOG_ERROR("It is NOT enough to send a Cts from now, drop it.");
+		NS_LOG_DEBUG("It is NOT enough to send a Cts from now, drop it.");
+		if (!m_reservationDroppedCallback.IsNull())
+		{
+			m_reservationDroppedCallback(m_currentHdr, RESERVATION_DROP_LATE_CTS);
+		}
 		m_currentPacket = 0;
 		return;
 	}
 
-	NS_LOG_ERROR("Sending Cts, dst="<<m_currentHdr.GetAddr1()
+	NS_LOG_DEBUG("Sending Cts, dst="<<m_currentHdr.GetAddr1()
 			<<", src="<<m_currentHdr.GetAddr2());
 	ForwardDown(m_currentPacket, &m_currentHdr, ctsTxMode);
 	m_currentPacket = 0;
@@ -185,13 +193,14 @@ void MacLowCtrl::SendCtsPacket()
 void MacLowCtrl::ReceiveOk(Ptr<Packet> packet, double rxSnr, WifiMode txMode,
 		WifiPreamble preamble)
 {
-
-	Ptr<Packet> myPacket = packet->Copy();
 	WifiMacHeader myHdr;
-	myPacket->RemoveHeader(myHdr);
+	packet->PeekHeader(myHdr);
 
 	if (myHdr.IsRts() || myHdr.IsCts()) // notify data channel if it is RTS/CTS
 	{
+		// the packet is already our own copy, no need to copy it again
+		// before removing the header.
+		packet->RemoveHeader(myHdr);
 		Mac48Address addr = myHdr.IsRts() ? myHdr.GetAddr2() : myHdr.GetAddr1();
 		m_stationManager->ReportRxOk(addr, &myHdr, rxSnr, txMode);
 
@@ -207,7 +216,7 @@ void MacLowCtrl::ReceiveOk(Ptr<Packet> packet, double rxSnr, WifiMode txMode,
 		// NOTE: the header is removed!
 		if (!m_notifyDataChannelCallback.IsNull())
 		{
-			m_notifyDataChannelCallback(myPacket, myHdr);
+			m_notifyDataChannelCallback(packet, myHdr);
 		}
 		else
 		{
@@ -233,13 +242,19 @@ void MacLowCtrl::SetGetDataChannelStateCallback(
 	m_getDataChannelStateCallback = callback;
 }
 
-void MacLowCtrl::NotifyRxStartNow(Time rxDuration, WifiMacHeader hdr,
+void MacLowCtrl::SetReservationDroppedCallback(
+		ReservationDroppedCallback callback)
+{
+	m_reservationDroppedCallback = callback;
+}
+
+void MacLowCtrl::NotifyRxStartNow(Time rxDuration, const WifiMacHeader &hdr,
 		Ptr<const Packet> packet)
 {
 	MacLow::NotifyRxStartNow(rxDuration, hdr, packet);
 	if (hdr.IsRts() || hdr.IsCts())
 	{
-		NS_LOG_ERROR(
+		NS_LOG_DEBUG(
 				(hdr.IsRts() ? "Rxing Rts" : "Rxing Cts")
 				<<", dst="<<hdr.GetAddr1()
 				<<", src="<<hdr.GetAddr2()
@@ -248,7 +263,7 @@ void MacLowCtrl::NotifyRxStartNow(Time rxDuration, WifiMacHeader hdr,
 	}
 }
 
-void MacLowCtrl::NotifyTxStartNow(Time duration, WifiMacHeader hdr)
+void MacLowCtrl::NotifyTxStartNow(Time duration, const WifiMacHeader &hdr)
 {
 	MacLow::NotifyTxStartNow(duration, hdr);
 }
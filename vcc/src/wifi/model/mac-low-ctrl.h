@@ -42,6 +42,7 @@
 #include "qos-utils.h"
 #include "block-ack-cache.h"
 #include "mac-low.h"
+#include "reservation-drop-reason.h"
 
 namespace ns3 {
 
@@ -56,6 +57,7 @@ public:
 
 	typedef Callback <void, Ptr<Packet>, WifiMacHeader > NotifyDataChannelCallback;
 	typedef Callback<void, Time &, Time &, Time &, Time &, Time &, Time &> GetDataChannelStaeCallback;
+	typedef Callback<void, const WifiMacHeader &, ReservationDropReason> ReservationDroppedCallback;
 
 
   MacLowCtrl ();
@@ -74,15 +76,22 @@ public:
 
   void SetNotifyDataChannelCallback(NotifyDataChannelCallback callback);
   void SetGetDataChannelStateCallback(GetDataChannelStaeCallback callback);
+  /**
+   * \param callback invoked with the header of an RTS or a CTS which is
+   * dropped because it can not be sent before the end of the on-air
+   * data frame.
+   */
+  void SetReservationDroppedCallback(ReservationDroppedCallback callback);
 
-  virtual void NotifyRxStartNow(Time rxDuration, WifiMacHeader hdr, Ptr<const Packet> packet);
-    virtual void NotifyTxStartNow(Time duration, WifiMacHeader hdr);
+  virtual void NotifyRxStartNow(Time rxDuration, const WifiMacHeader &hdr, Ptr<const Packet> packet);
+    virtual void NotifyTxStartNow(Time duration, const WifiMacHeader &hdr);
 
 private:
   WifiMode m_lastRtsTxMode;
   double m_lastSnr;
   NotifyDataChannelCallback m_notifyDataChannelCallback;
   GetDataChannelStaeCallback m_getDataChannelStateCallback;
+  ReservationDroppedCallback m_reservationDroppedCallback;
 
 };
 
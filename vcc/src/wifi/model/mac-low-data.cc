@@ -27,6 +27,7 @@
 #include "ns3/log.h"
 #include "ns3/node.h"
 #include "ns3/double.h"
+#include "ns3/boolean.h"
 
 #include "mac-low-data.h"
 #include "wifi-phy.h"
@@ -42,7 +43,23 @@ NS_LOG_COMPONENT_DEFINE("MacLowData");
 namespace ns3
 {
 
-MacLowData::MacLowData()
+NS_OBJECT_ENSURE_REGISTERED(MacLowData);
+
+TypeId MacLowData::GetTypeId(void)
+{
+	static TypeId tid = TypeId("ns3::MacLowData").SetParent<Object>()
+			.AddConstructor<MacLowData>()
+			.AddAttribute("NavGapFilling",
+					"If true, a CTS may reserve a free slot between two known reservations "
+					"instead of the end of the last one.",
+					BooleanValue(true),
+					MakeBooleanAccessor(&MacLowData::m_navGapFilling),
+					MakeBooleanChecker());
+	return tid;
+}
+
+MacLowData::MacLowData() :
+		m_navGapFilling(true)
 {
 
 }
@@ -74,23 +91,31 @@ void MacLowData::SetupRtsForDataPacket(Ptr<const Packet> packet,
 	WifiMode rtsTxMode = GetRtsTxMode(packet, &hdr);
 	Time duration = Seconds(0);
 
-	WifiMode dataTxMode = GetDataTxMode(packet, &hdr);
 //	duration += GetSifs(); // this SIFS is the waiting time before replying CTS, we don't need it any more.
 //	duration += GetCtsDuration(hdr.GetAddr1(), rtsTxMode); // As the CTS is NOT transmitted on the data channel, do NOT need any more
-	duration += GetSifs();
-	duration += m_phy->CalculateTxDuration(GetSize(packet, &hdr), dataTxMode,
-			WIFI_PREAMBLE_LONG);
-	duration += GetSifs();
-	duration += GetAckDuration(hdr.GetAddr1(), dataTxMode);
+	duration += GetDataExchangeDuration(packet, hdr);
 
 	rtsHdr.SetDuration(duration);
 
 	// TODO: Now, we don't consider the re-transmission of Rts
-	Time txDuration = m_phy->CalculateTxDuration(GetRtsSize(), rtsTxMode,
+	Time txDuration = m_phy->GetTxDuration(GetRtsSize(), rtsTxMode,
 			WIFI_PREAMBLE_LONG);
 	*pDelay = txDuration + GetCtsTimeout() + GetSifs();
 }
 
+bool MacLowData::ExtendRtsForDataPacket(Ptr<const Packet> packet,
+		const WifiMacHeader& hdr, WifiMacHeader & rtsHdr)
+{
+	Time duration = rtsHdr.GetDuration() + GetDataExchangeDuration(packet, hdr);
+	if (duration.GetMicroSeconds() > 0x7fff)
+	{
+		return false;
+	}
+
+	rtsHdr.SetDuration(duration);
+	return true;
+}
+
 // create a CTS packet according to RTS packet
 void MacLowData::SetupCtsForRts(Ptr<const Packet> rtsPacket,
 		const WifiMacHeader& rtsHdr, Ptr<Packet> & ctsPacket,
@@ -118,7 +143,7 @@ void MacLowData::ScheduleNav(Time &start, Time & duration)
 {
 	Time now = Simulator::Now();
 
-	NS_LOG_ERROR("Try to schedule a NAV: "
+	NS_LOG_DEBUG("Try to schedule a NAV: "
 			<<"start = " <<start
 			<<", duration = "<<duration
 			<<", NavStart = "<<m_lastNavStart
@@ -132,26 +157,47 @@ void MacLowData::ScheduleNav(Time &start, Time & duration)
 	Time lastTxEnd = m_myLastTxStart + m_myLastTxDuration;
 	Time lastRxEnd = m_myLastRxStart + m_myLastRxDuration;
 
-	start = std::max(lastNavEnd, std::max(lastTxEnd, lastRxEnd));
+	if (m_navGapFilling)
+	{
+		// take the first slot which is free after the on-going transmissions
+		m_navSchedule.Purge(now);
+		Time earliest = std::max(now, std::max(lastTxEnd, lastRxEnd));
+		start = m_navSchedule.FindFreeSlot(earliest, duration);
+	}
+	else
+	{
+		start = std::max(lastNavEnd, std::max(lastTxEnd, lastRxEnd));
+	}
 	NS_ASSERT(start > now);
 	Time end = start + duration;
-	Time realDuration = end - now;
+	AddReservation(start, duration);
 
-	for (DcfListenersCI i = m_dcfListeners.begin(); i != m_dcfListeners.end();
-			i++)
+	// the NAV only covers the reservations, it never shrinks
+	if (end > lastNavEnd)
 	{
-		(*i)->NavStart(realDuration);
-	}
+		Time realDuration = end - now;
+		for (DcfListenersCI i = m_dcfListeners.begin();
+				i != m_dcfListeners.end(); i++)
+		{
+			(*i)->NavStart(realDuration);
+		}
 
-	m_lastNavStart = now;
-	m_lastNavDuration = realDuration;
+		m_lastNavStart = now;
+		m_lastNavDuration = realDuration;
 
-	NS_LOG_ERROR("new NAV: start = " << now << ", duration = " << realDuration);
+		NS_LOG_DEBUG("new NAV: start = " << now << ", duration = " << realDuration);
+	}
+	else
+	{
+		NS_LOG_DEBUG("reservation in a gap: start = " << start << ", end = " << end);
+	}
 
 }
 
 void MacLowData::UpdateNav(const Time & start, const Time & duration)
 {
+	AddReservation(start, duration);
+
 	Time lastNavEnd = m_lastNavStart + m_lastNavDuration;
 	Time newNavEnd = start + duration;
 	if (newNavEnd > lastNavEnd)
@@ -171,7 +217,7 @@ void MacLowData::UpdateNav(const Time & start, const Time & duration)
 	}
 	else
 	{
-		NS_LOG_ERROR("Nav doesn't change");
+		NS_LOG_DEBUG("Nav doesn't change");
 	}
 }
 
@@ -184,7 +230,7 @@ void MacLowData::GotCtsPacket(Ptr<const Packet> packet,
 	packet->CopyData((uint8_t *) (&startTime), sizeof(uint64_t));
 	Time start(startTime);
 
-	NS_LOG_ERROR("Got CTS: dst=" <<hdr.GetAddr1()
+	NS_LOG_DEBUG("Got CTS: dst=" <<hdr.GetAddr1()
 			<<", src="<<hdr.GetAddr2()
 			<<", duration="<<hdr.GetDuration()
 			<<", start="<<start );
@@ -200,14 +246,14 @@ void MacLowData::ReceiveOk(Ptr<Packet> packet, double rxSnr, WifiMode txMode,
 	packet->PeekHeader(hdr);
 	if (hdr.GetAddr1() == m_self && hdr.IsData() &&  packet->GetSize() > 512)
 	{
-		NS_LOG_ERROR ("Receive data OK, src = " << hdr.GetAddr2 ()
+		NS_LOG_DEBUG ("Receive data OK, src = " << hdr.GetAddr2 ()
 				<<", size = " << packet->GetSize() );
 	}
 
 	MacLow::ReceiveOk(packet, rxSnr, txMode, preamble);
 }
 
-void MacLowData::NotifyRxStartNow(Time rxDuration, WifiMacHeader hdr, Ptr<const Packet> packet)
+void MacLowData::NotifyRxStartNow(Time rxDuration, const WifiMacHeader &hdr, Ptr<const Packet> packet)
 {
 	// Note: we must call MacLow::NotifyRxStartNow() here!
 	MacLow::NotifyRxStartNow(rxDuration, hdr, packet);
@@ -221,7 +267,7 @@ void MacLowData::NotifyRxStartNow(Time rxDuration, WifiMacHeader hdr, Ptr<const
 	m_rxStartCallback(rxDuration, hdr, packet);
 }
 
-void MacLowData::NotifyTxStartNow(Time duration, WifiMacHeader hdr)
+void MacLowData::NotifyTxStartNow(Time duration, const WifiMacHeader &hdr)
 {
 	// Note: we must call MacLow::NotifyTxStartNow() here!
 	MacLow::NotifyTxStartNow(duration, hdr);
@@ -235,6 +281,12 @@ void MacLowData::NotifyTxStartNow(Time duration, WifiMacHeader hdr)
 	m_txStartCallback(duration, hdr);
 }
 
+bool MacLowData::DoNavStartNow(Time duration)
+{
+	AddReservation(Simulator::Now(), duration);
+	return MacLow::DoNavStartNow(duration);
+}
+
 void MacLowData::SetNotifyRxStartCallback(NotifyRxStartCallback callback)
 {
 	m_rxStartCallback = callback;
@@ -257,25 +309,65 @@ bool MacLowData::IsValidCts(Ptr<const Packet> ctsPacket,
 	Time txEnd = m_myLastTxStart + m_myLastTxDuration;
 	Time rxEnd = m_myLastRxStart + m_myLastRxDuration;
 
-	if (start <= navEnd)
+	if (m_navGapFilling)
 	{
-		NS_LOG_ERROR("Invalid Cts, start="<<start<<", navEnd="<<navEnd);
+		// the reserved transmission must not overlap what this MAC knows
+		Time end = start - GetSifs() + hdr.GetDuration();
+		m_navSchedule.Purge(Simulator::Now());
+		if (!m_navSchedule.IsFree(start, end))
+		{
+			NS_LOG_DEBUG("Invalid Cts, start="<<start<<", end="<<end
+					<<" overlaps a reservation");
+			return false;
+		}
+	}
+	else if (start <= navEnd)
+	{
+		NS_LOG_DEBUG("Invalid Cts, start="<<start<<", navEnd="<<navEnd);
 		return false;
 	}
 
 	if (start <= txEnd)
 	{
-		NS_LOG_ERROR("Invalid Cts, start="<<start<<", txEnd="<<txEnd);
+		NS_LOG_DEBUG("Invalid Cts, start="<<start<<", txEnd="<<txEnd);
 		return false;
 	}
 
 	if (start <= rxEnd)
 	{
-		NS_LOG_ERROR("Invalid Cts, start="<<start<<", rxEnd="<<rxEnd);
+		NS_LOG_DEBUG("Invalid Cts, start="<<start<<", rxEnd="<<rxEnd);
 		return false;
 	}
 
 	return true;
 }
 
+const NavSchedule & MacLowData::GetNavSchedule(void) const
+{
+	return m_navSchedule;
+}
+
+
+Time MacLowData::GetDataExchangeDuration(Ptr<const Packet> packet,
+		const WifiMacHeader& hdr)
+{
+	WifiMode dataTxMode = GetDataTxMode(packet, &hdr);
+	Time duration = GetSifs();
+	duration += m_phy->GetTxDuration(GetSize(packet, &hdr), dataTxMode,
+			WIFI_PREAMBLE_LONG);
+	duration += GetSifs();
+	duration += GetAckDuration(hdr.GetAddr1(), dataTxMode);
+	return duration;
+}
+
+void MacLowData::AddReservation(const Time & start, const Time & duration)
+{
+	if (!m_navGapFilling)
+	{
+		return;
+	}
+	m_navSchedule.Purge(Simulator::Now());
+	m_navSchedule.Add(start, start + duration);
+}
+
 } // namespace ns3
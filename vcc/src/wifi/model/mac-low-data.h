@@ -42,6 +42,7 @@
 #include "qos-utils.h"
 #include "block-ack-cache.h"
 #include "mac-low.h"
+#include "nav-schedule.h"
 
 namespace ns3
 {
@@ -53,8 +54,10 @@ namespace ns3
 class MacLowData: public MacLow
 {
 public:
-	typedef Callback<void, Time, WifiMacHeader , Ptr<const Packet> > NotifyRxStartCallback;
-	typedef Callback<void, Time, WifiMacHeader> NotifyTxStartCallback;
+	typedef Callback<void, Time, const WifiMacHeader &, Ptr<const Packet> > NotifyRxStartCallback;
+	typedef Callback<void, Time, const WifiMacHeader &> NotifyTxStartCallback;
+
+	static TypeId GetTypeId(void);
 
 	MacLowData();
 	virtual ~MacLowData();
@@ -63,6 +66,21 @@ public:
 			const WifiMacHeader& hdr, Ptr<Packet> & rtsPacket,
 			WifiMacHeader & rtsHdr, Time *pDelay);
 
+	/**
+	 * \param packet a data packet which follows the one an RTS has been
+	 * set up for
+	 * \param hdr the header of this data packet
+	 * \param rtsHdr the header of the RTS
+	 * \returns true if the RTS duration could be extended to reserve the
+	 * transmission of this packet too, false if the duration field
+	 * would overflow.
+	 *
+	 * The packets of a burst are separated by a SIFS, each one is
+	 * acknowledged before the next one starts.
+	 */
+	bool ExtendRtsForDataPacket(Ptr<const Packet> packet,
+			const WifiMacHeader& hdr, WifiMacHeader & rtsHdr);
+
 	void SetupCtsForRts(Ptr<const Packet> packet, const WifiMacHeader& hdr,
 			Ptr<Packet> & ctsPacket, WifiMacHeader & ctsHdr);
 
@@ -75,9 +93,15 @@ public:
 	virtual void ReceiveOk(Ptr<Packet> packet, double rxSnr, WifiMode txMode,
 			WifiPreamble preamble);
 
-	virtual void NotifyRxStartNow(Time rxDuration, WifiMacHeader hdr, Ptr<const Packet> packet);
+	virtual void NotifyRxStartNow(Time rxDuration, const WifiMacHeader &hdr, Ptr<const Packet> packet);
+
+	virtual void NotifyTxStartNow(Time duration, const WifiMacHeader &hdr);
 
-	virtual void NotifyTxStartNow(Time duration, WifiMacHeader hdr);
+	/**
+	 * Set the NAV from the duration of a frame overheard on the data
+	 * channel, and record it in the reservations.
+	 */
+	virtual bool DoNavStartNow(Time duration);
 
 	void SetNotifyRxStartCallback(NotifyRxStartCallback callback);
 
@@ -85,10 +109,26 @@ public:
 
 	bool IsValidCts(Ptr<const Packet> ctsPacket, const WifiMacHeader& hdr);
 
+	/**
+	 * \returns the data channel reservations known by this MAC.
+	 */
+	const NavSchedule & GetNavSchedule(void) const;
+
 private:
+	/**
+	 * \returns the time needed to send a data packet after a SIFS and to
+	 * get its ACK.
+	 */
+	Time GetDataExchangeDuration(Ptr<const Packet> packet,
+			const WifiMacHeader& hdr);
+	void AddReservation(const Time & start, const Time & duration);
+
 	NotifyRxStartCallback m_rxStartCallback;
 	NotifyTxStartCallback m_txStartCallback;
 
+	bool m_navGapFilling;
+	NavSchedule m_navSchedule;
+
 };
 
 } // namespace ns3
@@ -309,7 +309,7 @@ public:
   virtual ~PhyMacLowListener ()
   {
   }
-  virtual void NotifyRxStart (Time rxDuration, WifiMacHeader hdr, Ptr<const Packet> packet)
+  virtual void NotifyRxStart (Time rxDuration, const WifiMacHeader &hdr, Ptr<const Packet> packet)
   {
 	  m_macLow->NotifyRxStartNow(rxDuration, hdr, packet);
   }
@@ -319,7 +319,7 @@ public:
   virtual void NotifyRxEndError (void)
   {
   }
-  virtual void NotifyTxStart (Time duration, WifiMacHeader hdr)
+  virtual void NotifyTxStart (Time duration, const WifiMacHeader &hdr)
   {
 	  m_macLow->NotifyTxStartNow(duration, hdr);
   }
@@ -348,7 +348,8 @@ MacLow::MacLow ()
     m_waitSifsEvent (),
     m_endTxNoAckEvent (),
     m_currentPacket (0),
-    m_listener (0)
+    m_listener (0),
+    m_phyMacLowListener (0)
 {
   NS_LOG_FUNCTION (this);
   m_lastNavDuration = Seconds (0);
@@ -951,7 +952,7 @@ Time
 MacLow::GetAckDuration (Mac48Address to, WifiMode dataTxMode) const
 {
   WifiMode ackMode = GetAckTxModeForData (to, dataTxMode);
-  return m_phy->CalculateTxDuration (GetAckSize (), ackMode, WIFI_PREAMBLE_LONG);
+  return m_phy->GetTxDuration (GetAckSize (), ackMode, WIFI_PREAMBLE_LONG);
 }
 Time
 MacLow::GetBlockAckDuration (Mac48Address to, WifiMode blockAckReqTxMode, enum BlockAckType type) const
@@ -964,13 +965,13 @@ MacLow::GetBlockAckDuration (Mac48Address to, WifiMode blockAckReqTxMode, enum B
    * The BlockAck control frame shall be sent at the same rate and modulation class as
    * the BlockAckReq frame if it is sent in response to a BlockAckReq frame.
    */
-  return m_phy->CalculateTxDuration (GetBlockAckSize (type), blockAckReqTxMode, WIFI_PREAMBLE_LONG);
+  return m_phy->GetTxDuration (GetBlockAckSize (type), blockAckReqTxMode, WIFI_PREAMBLE_LONG);
 }
 Time
 MacLow::GetCtsDuration (Mac48Address to, WifiMode rtsTxMode) const
 {
   WifiMode ctsMode = GetCtsTxModeForRts (to, rtsTxMode);
-  return m_phy->CalculateTxDuration (GetCtsSize (), ctsMode, WIFI_PREAMBLE_LONG);
+  return m_phy->GetTxDuration (GetCtsSize (), ctsMode, WIFI_PREAMBLE_LONG);
 }
 uint32_t
 MacLow::GetCtsSize (void) const
@@ -1023,12 +1024,12 @@ MacLow::CalculateOverallTxTime (Ptr<const Packet> packet,
   WifiMode dataMode = GetDataTxMode (packet, hdr);
   if (params.MustSendRts ())
     {
-      txTime += m_phy->CalculateTxDuration (GetRtsSize (), rtsMode, WIFI_PREAMBLE_LONG);
+      txTime += m_phy->GetTxDuration (GetRtsSize (), rtsMode, WIFI_PREAMBLE_LONG);
       txTime += GetCtsDuration (hdr->GetAddr1 (), rtsMode);
       txTime += Time (GetSifs () * 2);
     }
   uint32_t dataSize = GetSize (packet, hdr);
-  txTime += m_phy->CalculateTxDuration (dataSize, dataMode, WIFI_PREAMBLE_LONG);
+  txTime += m_phy->GetTxDuration (dataSize, dataMode, WIFI_PREAMBLE_LONG);
   if (params.MustWaitAck ())
     {
       txTime += GetSifs ();
@@ -1047,7 +1048,7 @@ MacLow::CalculateTransmissionTime (Ptr<const Packet> packet,
     {
       WifiMode dataMode = GetDataTxMode (packet, hdr);
       txTime += GetSifs ();
-      txTime += m_phy->CalculateTxDuration (params.GetNextPacketSize (), dataMode, WIFI_PREAMBLE_LONG);
+      txTime += m_phy->GetTxDuration (params.GetNextPacketSize (), dataMode, WIFI_PREAMBLE_LONG);
     }
   return txTime;
 }
@@ -1084,7 +1085,7 @@ MacLow::NotifyNav (const WifiMacHeader &hdr, WifiMode txMode, WifiPreamble pream
           WifiMacHeader cts;
           cts.SetType (WIFI_MAC_CTL_CTS);
           Time navCounterResetCtsMissedDelay =
-            m_phy->CalculateTxDuration (cts.GetSerializedSize (), txMode, preamble) +
+            m_phy->GetTxDuration (cts.GetSerializedSize (), txMode, preamble) +
             Time (2 * GetSifs ()) + Time (2 * GetSlotTime ());
           m_navCounterResetCtsMissed = Simulator::Schedule (navCounterResetCtsMissedDelay,
                                                             &MacLow::NavCounterResetCtsMissed, this,
@@ -1276,14 +1277,14 @@ MacLow::SendRtsForPacket (void)
       duration += GetSifs ();
       duration += GetCtsDuration (m_currentHdr.GetAddr1 (), rtsTxMode);
       duration += GetSifs ();
-      duration += m_phy->CalculateTxDuration (GetSize (m_currentPacket, &m_currentHdr),
-                                              dataTxMode, WIFI_PREAMBLE_LONG);
+      duration += m_phy->GetTxDuration (GetSize (m_currentPacket, &m_currentHdr),
+                                        dataTxMode, WIFI_PREAMBLE_LONG);
       duration += GetSifs ();
       duration += GetAckDuration (m_currentHdr.GetAddr1 (), dataTxMode);
     }
   rts.SetDuration (duration);
 
-  Time txDuration = m_phy->CalculateTxDuration (GetRtsSize (), rtsTxMode, WIFI_PREAMBLE_LONG);
+  Time txDuration = m_phy->GetTxDuration (GetRtsSize (), rtsTxMode, WIFI_PREAMBLE_LONG);
   Time timerDelay = txDuration + GetCtsTimeout ();
 
   NS_ASSERT (m_ctsTimeoutEvent.IsExpired ());
@@ -1303,7 +1304,7 @@ void
 MacLow::StartDataTxTimers (void)
 {
   WifiMode dataTxMode = GetDataTxMode (m_currentPacket, &m_currentHdr);
-  Time txDuration = m_phy->CalculateTxDuration (GetSize (m_currentPacket, &m_currentHdr), dataTxMode, WIFI_PREAMBLE_LONG);
+  Time txDuration = m_phy->GetTxDuration (GetSize (m_currentPacket, &m_currentHdr), dataTxMode, WIFI_PREAMBLE_LONG);
   if (m_txParams.MustWaitNormalAck ())
     {
       Time timerDelay = txDuration + GetAckTimeout ();
@@ -1385,8 +1386,8 @@ MacLow::SendDataPacket (void)
       if (m_txParams.HasNextPacket ())
         {
           duration += GetSifs ();
-          duration += m_phy->CalculateTxDuration (m_txParams.GetNextPacketSize (),
-                                                  dataTxMode, WIFI_PREAMBLE_LONG);
+          duration += m_phy->GetTxDuration (m_txParams.GetNextPacketSize (),
+                                            dataTxMode, WIFI_PREAMBLE_LONG);
           if (m_txParams.MustWaitAck ())
             {
               duration += GetSifs ();
@@ -1466,8 +1467,8 @@ MacLow::SendDataAfterCts (Mac48Address source, Time duration, WifiMode txMode)
   Time newDuration = Seconds (0);
   newDuration += GetSifs ();
   newDuration += GetAckDuration (m_currentHdr.GetAddr1 (), dataTxMode);
-  Time txDuration = m_phy->CalculateTxDuration (GetSize (m_currentPacket, &m_currentHdr),
-                                                dataTxMode, WIFI_PREAMBLE_LONG);
+  Time txDuration = m_phy->GetTxDuration (GetSize (m_currentPacket, &m_currentHdr),
+                                          dataTxMode, WIFI_PREAMBLE_LONG);
   duration -= txDuration;
   duration -= GetSifs ();
 
@@ -1851,13 +1852,13 @@ MacLow::RegisterBlockAckListenerForAc (enum AcIndex ac, MacLowBlockAckEventListe
   m_edcaListeners.insert (std::make_pair (ac, listener));
 }
 
-void MacLow::NotifyRxStartNow(Time rxDuration, WifiMacHeader hdr, Ptr<const Packet> packet)
+void MacLow::NotifyRxStartNow(Time rxDuration, const WifiMacHeader &hdr, Ptr<const Packet> packet)
 {
 	m_myLastRxStart = Simulator::Now();
 	m_myLastRxDuration = rxDuration + hdr.GetDuration();
 }
 
-void MacLow::NotifyTxStartNow(Time duration, WifiMacHeader hdr)
+void MacLow::NotifyTxStartNow(Time duration, const WifiMacHeader &hdr)
 {
 	m_myLastTxStart = Simulator::Now();
 	m_myLastTxDuration = duration + hdr.GetDuration();
@@ -548,7 +548,7 @@ public:
   Time GetBlockAckDuration (Mac48Address to, WifiMode blockAckReqTxMode, enum BlockAckType type) const;
   void NotifyNav (const WifiMacHeader &hdr, WifiMode txMode, WifiPreamble preamble);
   void DoNavResetNow (Time duration);
-  bool DoNavStartNow (Time duration);
+  virtual bool DoNavStartNow (Time duration);
   bool IsNavZero (void) const;
   void NotifyAckTimeoutStartNow (Time duration);
   void NotifyAckTimeoutResetNow ();
@@ -688,8 +688,8 @@ public:
   QueueListeners m_edcaListeners;
 
 public:
-  virtual void NotifyRxStartNow(Time rxDuration, WifiMacHeader hdr, Ptr<const Packet> packet);
-  virtual void NotifyTxStartNow(Time duration, WifiMacHeader hdr);
+  virtual void NotifyRxStartNow(Time rxDuration, const WifiMacHeader &hdr, Ptr<const Packet> packet);
+  virtual void NotifyTxStartNow(Time duration, const WifiMacHeader &hdr);
 
 public:
   Time m_myLastRxStart;
@@ -74,6 +74,33 @@ struct MinstrelWifiRemoteStation : public WifiRemoteStation
   uint32_t m_txrate;  ///< current transmit rate
 
   bool m_initialized;  ///< for initializing tables
+
+  uint32_t m_nsupported;  ///< modes supported
+  const MinstrelRateSet *m_rates;  ///< the tables shared with the stations with the same rates
+
+  /**
+   * The minstrel table, one array per field indexed by rate. The arrays
+   * point into m_counters and m_history so that the table of a station
+   * takes two allocations whatever its number of rates.
+   */
+  std::vector<uint32_t> m_counters;
+  std::vector<uint64_t> m_history;
+  uint32_t *m_adjustedRetryCount;  ///< adjust the retry limit for this rate
+  uint32_t *m_numRateAttempt;  ///< how many number of attempts so far
+  uint32_t *m_numRateSuccess;  ///< number of successful pkts
+  uint32_t *m_prob;  ///< (# pkts success )/(# total pkts)
+
+  /**
+   * EWMA calculation
+   * ewma_prob =[prob *(100 - ewma_level) + (ewma_prob_old * ewma_level)]/100
+   */
+  uint32_t *m_ewmaProb;
+
+  uint32_t *m_prevNumRateAttempt;  ///< from last rate
+  uint32_t *m_prevNumRateSuccess;  ///< from last rate
+  uint32_t *m_throughput;  ///< throughput of a rate
+  uint64_t *m_successHist;  ///< aggregate of all successes
+  uint64_t *m_attemptHist;  ///< aggregate of all attempts
 };
 
 NS_OBJECT_ENSURE_REGISTERED (MinstrelWifiManager);
@@ -121,8 +148,6 @@ MinstrelWifiManager::GetTypeId (void)
 MinstrelWifiManager::MinstrelWifiManager ()
 {
   m_uniformRandomVariable = CreateObject<UniformRandomVariable> ();
-
-  m_nsupported = 0;
 }
 
 MinstrelWifiManager::~MinstrelWifiManager ()
@@ -193,6 +218,8 @@ MinstrelWifiManager::DoCreateStation (void) const
   station->m_err = 0;
   station->m_txrate = 0;
   station->m_initialized = false;
+  station->m_nsupported = 0;
+  station->m_rates = 0;
 
   return station;
 }
@@ -205,10 +232,25 @@ MinstrelWifiManager::CheckInit (MinstrelWifiRemoteStation *station)
       // Note: we appear to be doing late initialization of the table
       // to make sure that the set of supported rates has been initialized
       // before we perform our own initialization.
-      m_nsupported = GetNSupported (station);
-      m_minstrelTable = MinstrelRate (m_nsupported);
-      m_sampleTable = SampleRate (m_nsupported, std::vector<uint32_t> (m_sampleCol));
-      InitSampleTable (station);
+      uint32_t n = GetNSupported (station);
+      station->m_nsupported = n;
+      station->m_rates = GetRateSet (station);
+      station->m_col = station->m_index = 0;
+
+      station->m_counters.resize (8 * n);
+      station->m_history.resize (2 * n);
+      uint32_t *counters = &station->m_counters[0];
+      station->m_adjustedRetryCount = counters;
+      station->m_numRateAttempt = counters + n;
+      station->m_numRateSuccess = counters + 2 * n;
+      station->m_prob = counters + 3 * n;
+      station->m_ewmaProb = counters + 4 * n;
+      station->m_prevNumRateAttempt = counters + 5 * n;
+      station->m_prevNumRateSuccess = counters + 6 * n;
+      station->m_throughput = counters + 7 * n;
+      station->m_successHist = &station->m_history[0];
+      station->m_attemptHist = &station->m_history[n];
+
       RateInit (station);
       station->m_initialized = true;
     }
@@ -278,30 +320,30 @@ MinstrelWifiManager::DoReportDataFailed (WifiRemoteStation *st)
   if (!station->m_isSampling)
     {
       /// use best throughput rate
-      if (station->m_longRetry < m_minstrelTable[station->m_txrate].adjustedRetryCount)
+      if (station->m_longRetry < station->m_adjustedRetryCount[station->m_txrate])
         {
           ;  ///<  there's still a few retries left
         }
 
       /// use second best throughput rate
-      else if (station->m_longRetry <= (m_minstrelTable[station->m_txrate].adjustedRetryCount +
-                                        m_minstrelTable[station->m_maxTpRate].adjustedRetryCount))
+      else if (station->m_longRetry <= (station->m_adjustedRetryCount[station->m_txrate] +
+                                        station->m_adjustedRetryCount[station->m_maxTpRate]))
         {
           station->m_txrate = station->m_maxTpRate2;
         }
 
       /// use best probability rate
-      else if (station->m_longRetry <= (m_minstrelTable[station->m_txrate].adjustedRetryCount +
-                                        m_minstrelTable[station->m_maxTpRate2].adjustedRetryCount +
-                                        m_minstrelTable[station->m_maxTpRate].adjustedRetryCount))
+      else if (station->m_longRetry <= (station->m_adjustedRetryCount[station->m_txrate] +
+                                        station->m_adjustedRetryCount[station->m_maxTpRate2] +
+                                        station->m_adjustedRetryCount[station->m_maxTpRate]))
         {
           station->m_txrate = station->m_maxProbRate;
         }
 
       /// use lowest base rate
-      else if (station->m_longRetry > (m_minstrelTable[station->m_txrate].adjustedRetryCount +
-                                       m_minstrelTable[station->m_maxTpRate2].adjustedRetryCount +
-                                       m_minstrelTable[station->m_maxTpRate].adjustedRetryCount))
+      else if (station->m_longRetry > (station->m_adjustedRetryCount[station->m_txrate] +
+                                       station->m_adjustedRetryCount[station->m_maxTpRate2] +
+                                       station->m_adjustedRetryCount[station->m_maxTpRate]))
         {
           station->m_txrate = 0;
         }
@@ -314,30 +356,30 @@ MinstrelWifiManager::DoReportDataFailed (WifiRemoteStation *st)
       if (station->m_sampleRateSlower)
         {
           /// use best throughput rate
-          if (station->m_longRetry < m_minstrelTable[station->m_txrate].adjustedRetryCount)
+          if (station->m_longRetry < station->m_adjustedRetryCount[station->m_txrate])
             {
               ; ///<  there are a few retries left
             }
 
           ///	use random rate
-          else if (station->m_longRetry <= (m_minstrelTable[station->m_txrate].adjustedRetryCount +
-                                            m_minstrelTable[station->m_maxTpRate].adjustedRetryCount))
+          else if (station->m_longRetry <= (station->m_adjustedRetryCount[station->m_txrate] +
+                                            station->m_adjustedRetryCount[station->m_maxTpRate]))
             {
               station->m_txrate = station->m_sampleRate;
             }
 
           /// use max probability rate
-          else if (station->m_longRetry <= (m_minstrelTable[station->m_txrate].adjustedRetryCount +
-                                            m_minstrelTable[station->m_sampleRate].adjustedRetryCount +
-                                            m_minstrelTable[station->m_maxTpRate].adjustedRetryCount ))
+          else if (station->m_longRetry <= (station->m_adjustedRetryCount[station->m_txrate] +
+                                            station->m_adjustedRetryCount[station->m_sampleRate] +
+                                            station->m_adjustedRetryCount[station->m_maxTpRate] ))
             {
               station->m_txrate = station->m_maxProbRate;
             }
 
           /// use lowest base rate
-          else if (station->m_longRetry > (m_minstrelTable[station->m_txrate].adjustedRetryCount +
-                                           m_minstrelTable[station->m_sampleRate].adjustedRetryCount +
-                                           m_minstrelTable[station->m_maxTpRate].adjustedRetryCount))
+          else if (station->m_longRetry > (station->m_adjustedRetryCount[station->m_txrate] +
+                                           station->m_adjustedRetryCount[station->m_sampleRate] +
+                                           station->m_adjustedRetryCount[station->m_maxTpRate]))
             {
               station->m_txrate = 0;
             }
@@ -347,30 +389,30 @@ MinstrelWifiManager::DoReportDataFailed (WifiRemoteStation *st)
       else
         {
           /// use random rate
-          if (station->m_longRetry < m_minstrelTable[station->m_txrate].adjustedRetryCount)
+          if (station->m_longRetry < station->m_adjustedRetryCount[station->m_txrate])
             {
               ;    ///< keep using it
             }
 
           /// use the best rate
-          else if (station->m_longRetry <= (m_minstrelTable[station->m_txrate].adjustedRetryCount +
-                                            m_minstrelTable[station->m_sampleRate].adjustedRetryCount))
+          else if (station->m_longRetry <= (station->m_adjustedRetryCount[station->m_txrate] +
+                                            station->m_adjustedRetryCount[station->m_sampleRate]))
             {
               station->m_txrate = station->m_maxTpRate;
             }
 
           /// use the best probability rate
-          else if (station->m_longRetry <= (m_minstrelTable[station->m_txrate].adjustedRetryCount +
-                                            m_minstrelTable[station->m_maxTpRate].adjustedRetryCount +
-                                            m_minstrelTable[station->m_sampleRate].adjustedRetryCount))
+          else if (station->m_longRetry <= (station->m_adjustedRetryCount[station->m_txrate] +
+                                            station->m_adjustedRetryCount[station->m_maxTpRate] +
+                                            station->m_adjustedRetryCount[station->m_sampleRate]))
             {
               station->m_txrate = station->m_maxProbRate;
             }
 
           /// use the lowest base rate
-          else if (station->m_longRetry > (m_minstrelTable[station->m_txrate].adjustedRetryCount +
-                                           m_minstrelTable[station->m_maxTpRate].adjustedRetryCount +
-                                           m_minstrelTable[station->m_sampleRate].adjustedRetryCount))
+          else if (station->m_longRetry > (station->m_adjustedRetryCount[station->m_txrate] +
+                                           station->m_adjustedRetryCount[station->m_maxTpRate] +
+                                           station->m_adjustedRetryCount[station->m_sampleRate]))
             {
               station->m_txrate = 0;
             }
@@ -393,15 +435,15 @@ MinstrelWifiManager::DoReportDataOk (WifiRemoteStation *st,
       return;
     }
 
-  m_minstrelTable[station->m_txrate].numRateSuccess++;
-  m_minstrelTable[station->m_txrate].numRateAttempt++;
+  station->m_numRateSuccess[station->m_txrate]++;
+  station->m_numRateAttempt[station->m_txrate]++;
 
   UpdateRetry (station);
 
-  m_minstrelTable[station->m_txrate].numRateAttempt += station->m_retry;
+  station->m_numRateAttempt[station->m_txrate] += station->m_retry;
   station->m_packetCount++;
 
-  if (m_nsupported >= 1)
+  if (station->m_nsupported >= 1)
     {
       station->m_txrate = FindRate (station);
     }
@@ -418,10 +460,10 @@ MinstrelWifiManager::DoReportFinalDataFailed (WifiRemoteStation *st)
 
   UpdateRetry (station);
 
-  m_minstrelTable[station->m_txrate].numRateAttempt += station->m_retry;
+  station->m_numRateAttempt[station->m_txrate] += station->m_retry;
   station->m_err++;
 
-  if (m_nsupported >= 1)
+  if (station->m_nsupported >= 1)
     {
       station->m_txrate = FindRate (station);
     }
@@ -445,7 +487,7 @@ MinstrelWifiManager::DoGetDataMode (WifiRemoteStation *st,
       CheckInit (station);
 
       /// start the rate at half way
-      station->m_txrate = m_nsupported / 2;
+      station->m_txrate = station->m_nsupported / 2;
     }
   UpdateStats (station);
   return GetSupported (station, station->m_txrate);
@@ -469,11 +511,11 @@ uint32_t
 MinstrelWifiManager::GetNextSample (MinstrelWifiRemoteStation *station)
 {
   uint32_t bitrate;
-  bitrate = m_sampleTable[station->m_index][station->m_col];
+  bitrate = station->m_rates->sampleTable[station->m_index][station->m_col];
   station->m_index++;
 
   /// bookeeping for m_index and m_col variables
-  if (station->m_index > (m_nsupported - 2))
+  if (station->m_index > (station->m_nsupported - 2))
     {
       station->m_index = 0;
       station->m_col++;
@@ -535,7 +577,7 @@ MinstrelWifiManager::FindRate (MinstrelWifiRemoteStation *station)
             }
 
           /// error check
-          if (idx >= m_nsupported)
+          if (idx >= station->m_nsupported)
             {
               NS_LOG_DEBUG ("ALERT!!! ERROR");
             }
@@ -550,7 +592,7 @@ MinstrelWifiManager::FindRate (MinstrelWifiRemoteStation *station)
 
           /// is this rate slower than the current best rate
           station->m_sampleRateSlower =
-            (m_minstrelTable[idx].perfectTxTime > m_minstrelTable[station->m_maxTpRate].perfectTxTime);
+            (station->m_rates->perfectTxTime[idx] > station->m_rates->perfectTxTime[station->m_maxTpRate]);
 
           /// using the best rate instead
           if (station->m_sampleRateSlower)
@@ -592,11 +634,11 @@ MinstrelWifiManager::UpdateStats (MinstrelWifiRemoteStation *station)
   Time txTime;
   uint32_t tempProb;
 
-  for (uint32_t i = 0; i < m_nsupported; i++)
+  for (uint32_t i = 0; i < station->m_nsupported; i++)
     {
 
       /// calculate the perfect tx time for this rate
-      txTime = m_minstrelTable[i].perfectTxTime;
+      txTime = station->m_rates->perfectTxTime[i];
 
       /// just for initialization
       if (txTime.GetMicroSeconds () == 0)
@@ -605,61 +647,61 @@ MinstrelWifiManager::UpdateStats (MinstrelWifiRemoteStation *station)
         }
 
       NS_LOG_DEBUG ("m_txrate=" << station->m_txrate <<
-                    "\t attempt=" << m_minstrelTable[i].numRateAttempt <<
-                    "\t success=" << m_minstrelTable[i].numRateSuccess);
+                    "\t attempt=" << station->m_numRateAttempt[i] <<
+                    "\t success=" << station->m_numRateSuccess[i]);
 
       /// if we've attempted something
-      if (m_minstrelTable[i].numRateAttempt)
+      if (station->m_numRateAttempt[i])
         {
           /**
            * calculate the probability of success
            * assume probability scales from 0 to 18000
            */
-          tempProb = (m_minstrelTable[i].numRateSuccess * 18000) / m_minstrelTable[i].numRateAttempt;
+          tempProb = (station->m_numRateSuccess[i] * 18000) / station->m_numRateAttempt[i];
 
           /// bookeeping
-          m_minstrelTable[i].successHist += m_minstrelTable[i].numRateSuccess;
-          m_minstrelTable[i].attemptHist += m_minstrelTable[i].numRateAttempt;
-          m_minstrelTable[i].prob = tempProb;
+          station->m_successHist[i] += station->m_numRateSuccess[i];
+          station->m_attemptHist[i] += station->m_numRateAttempt[i];
+          station->m_prob[i] = tempProb;
 
           /// ewma probability (cast for gcc 3.4 compatibility)
-          tempProb = static_cast<uint32_t> (((tempProb * (100 - m_ewmaLevel)) + (m_minstrelTable[i].ewmaProb * m_ewmaLevel) ) / 100);
+          tempProb = static_cast<uint32_t> (((tempProb * (100 - m_ewmaLevel)) + (station->m_ewmaProb[i] * m_ewmaLevel) ) / 100);
 
-          m_minstrelTable[i].ewmaProb = tempProb;
+          station->m_ewmaProb[i] = tempProb;
 
           /// calculating throughput
-          m_minstrelTable[i].throughput = tempProb * (1000000 / txTime.GetMicroSeconds ());
+          station->m_throughput[i] = tempProb * (1000000 / txTime.GetMicroSeconds ());
 
         }
 
       /// bookeeping
-      m_minstrelTable[i].prevNumRateAttempt = m_minstrelTable[i].numRateAttempt;
-      m_minstrelTable[i].prevNumRateSuccess = m_minstrelTable[i].numRateSuccess;
-      m_minstrelTable[i].numRateSuccess = 0;
-      m_minstrelTable[i].numRateAttempt = 0;
+      station->m_prevNumRateAttempt[i] = station->m_numRateAttempt[i];
+      station->m_prevNumRateSuccess[i] = station->m_numRateSuccess[i];
+      station->m_numRateSuccess[i] = 0;
+      station->m_numRateAttempt[i] = 0;
 
       /// Sample less often below 10% and  above 95% of success
-      if ((m_minstrelTable[i].ewmaProb > 17100) || (m_minstrelTable[i].ewmaProb < 1800))
+      if ((station->m_ewmaProb[i] > 17100) || (station->m_ewmaProb[i] < 1800))
         {
           /**
            * retry count denotes the number of retries permitted for each rate
            * # retry_count/2
            */
-          m_minstrelTable[i].adjustedRetryCount = m_minstrelTable[i].retryCount >> 1;
-          if (m_minstrelTable[i].adjustedRetryCount > 2)
+          station->m_adjustedRetryCount[i] = station->m_rates->retryCount[i] >> 1;
+          if (station->m_adjustedRetryCount[i] > 2)
             {
-              m_minstrelTable[i].adjustedRetryCount = 2;
+              station->m_adjustedRetryCount[i] = 2;
             }
         }
       else
         {
-          m_minstrelTable[i].adjustedRetryCount = m_minstrelTable[i].retryCount;
+          station->m_adjustedRetryCount[i] = station->m_rates->retryCount[i];
         }
 
       /// if it's 0 allow one retry limit
-      if (m_minstrelTable[i].adjustedRetryCount == 0)
+      if (station->m_adjustedRetryCount[i] == 0)
         {
-          m_minstrelTable[i].adjustedRetryCount = 1;
+          station->m_adjustedRetryCount[i] = 1;
         }
     }
 
@@ -667,33 +709,33 @@ MinstrelWifiManager::UpdateStats (MinstrelWifiRemoteStation *station)
   uint32_t max_prob = 0, index_max_prob = 0, max_tp = 0, index_max_tp = 0, index_max_tp2 = 0;
 
   /// go find max throughput, second maximum throughput, high probability succ
-  for (uint32_t i = 0; i < m_nsupported; i++)
+  for (uint32_t i = 0; i < station->m_nsupported; i++)
     {
-      NS_LOG_DEBUG ("throughput" << m_minstrelTable[i].throughput <<
-                    "\n ewma" << m_minstrelTable[i].ewmaProb);
+      NS_LOG_DEBUG ("throughput" << station->m_throughput[i] <<
+                    "\n ewma" << station->m_ewmaProb[i]);
 
-      if (max_tp < m_minstrelTable[i].throughput)
+      if (max_tp < station->m_throughput[i])
         {
           index_max_tp = i;
-          max_tp = m_minstrelTable[i].throughput;
+          max_tp = station->m_throughput[i];
         }
 
-      if (max_prob < m_minstrelTable[i].ewmaProb)
+      if (max_prob < station->m_ewmaProb[i])
         {
           index_max_prob = i;
-          max_prob = m_minstrelTable[i].ewmaProb;
+          max_prob = station->m_ewmaProb[i];
         }
     }
 
 
   max_tp = 0;
   /// find the second highest max
-  for (uint32_t i = 0; i < m_nsupported; i++)
+  for (uint32_t i = 0; i < station->m_nsupported; i++)
     {
-      if ((i != index_max_tp) && (max_tp < m_minstrelTable[i].throughput))
+      if ((i != index_max_tp) && (max_tp < station->m_throughput[i]))
         {
           index_max_tp2 = i;
-          max_tp = m_minstrelTable[i].throughput;
+          max_tp = station->m_throughput[i];
         }
     }
 
@@ -718,32 +760,53 @@ MinstrelWifiManager::RateInit (MinstrelWifiRemoteStation *station)
 {
   NS_LOG_DEBUG ("RateInit=" << station);
 
-  for (uint32_t i = 0; i < m_nsupported; i++)
+  for (uint32_t i = 0; i < station->m_nsupported; i++)
     {
-      m_minstrelTable[i].numRateAttempt = 0;
-      m_minstrelTable[i].numRateSuccess = 0;
-      m_minstrelTable[i].prob = 0;
-      m_minstrelTable[i].ewmaProb = 0;
-      m_minstrelTable[i].prevNumRateAttempt = 0;
-      m_minstrelTable[i].prevNumRateSuccess = 0;
-      m_minstrelTable[i].successHist = 0;
-      m_minstrelTable[i].attemptHist = 0;
-      m_minstrelTable[i].throughput = 0;
-      m_minstrelTable[i].perfectTxTime = GetCalcTxTime (GetSupported (station, i));
-      m_minstrelTable[i].retryCount = 1;
-      m_minstrelTable[i].adjustedRetryCount = 1;
+      station->m_numRateAttempt[i] = 0;
+      station->m_numRateSuccess[i] = 0;
+      station->m_prob[i] = 0;
+      station->m_ewmaProb[i] = 0;
+      station->m_prevNumRateAttempt[i] = 0;
+      station->m_prevNumRateSuccess[i] = 0;
+      station->m_successHist[i] = 0;
+      station->m_attemptHist[i] = 0;
+      station->m_throughput[i] = 0;
+      station->m_adjustedRetryCount[i] = 1;
     }
 }
 
+const MinstrelRateSet *
+MinstrelWifiManager::GetRateSet (MinstrelWifiRemoteStation *station)
+{
+  std::vector<uint32_t> uids;
+  for (uint32_t i = 0; i < station->m_nsupported; i++)
+    {
+      uids.push_back (GetSupported (station, i).GetUid ());
+    }
+  RateSets::iterator it = m_rateSets.find (uids);
+  if (it != m_rateSets.end ())
+    {
+      return &it->second;
+    }
+
+  MinstrelRateSet *rates = &m_rateSets[uids];
+  for (uint32_t i = 0; i < station->m_nsupported; i++)
+    {
+      rates->perfectTxTime.push_back (GetCalcTxTime (GetSupported (station, i)));
+      rates->retryCount.push_back (1);
+    }
+  rates->sampleTable = SampleRate (station->m_nsupported, std::vector<uint32_t> (m_sampleCol));
+  InitSampleTable (rates);
+  return rates;
+}
+
 void
-MinstrelWifiManager::InitSampleTable (MinstrelWifiRemoteStation *station)
+MinstrelWifiManager::InitSampleTable (MinstrelRateSet *rates)
 {
   NS_LOG_DEBUG ("InitSampleTable=" << this);
 
-  station->m_col = station->m_index = 0;
-
   /// for off-seting to make rates fall between 0 and numrates
-  uint32_t numSampleRates = m_nsupported;
+  uint32_t numSampleRates = rates->sampleTable.size ();
 
   uint32_t newIndex;
   for (uint32_t col = 0; col < m_sampleCol; col++)
@@ -759,11 +822,11 @@ MinstrelWifiManager::InitSampleTable (MinstrelWifiRemoteStation *station)
           newIndex = (i + uv) % numSampleRates;
 
           /// this loop is used for filling in other uninitilized places
-          while (m_sampleTable[newIndex][col] != 0)
+          while (rates->sampleTable[newIndex][col] != 0)
             {
-              newIndex = (newIndex + 1) % m_nsupported;
+              newIndex = (newIndex + 1) % numSampleRates;
             }
-          m_sampleTable[newIndex][col] = i;
+          rates->sampleTable[newIndex][col] = i;
 
         }
     }
@@ -774,12 +837,12 @@ MinstrelWifiManager::PrintSampleTable (MinstrelWifiRemoteStation *station)
 {
   NS_LOG_DEBUG ("PrintSampleTable=" << station);
 
-  uint32_t numSampleRates = m_nsupported;
+  uint32_t numSampleRates = station->m_nsupported;
   for (uint32_t i = 0; i < numSampleRates; i++)
     {
       for (uint32_t j = 0; j < m_sampleCol; j++)
         {
-          std::cout << m_sampleTable[i][j] << "\t";
+          std::cout << station->m_rates->sampleTable[i][j] << "\t";
         }
       std::cout << std::endl;
     }
@@ -790,9 +853,9 @@ MinstrelWifiManager::PrintTable (MinstrelWifiRemoteStation *station)
 {
   NS_LOG_DEBUG ("PrintTable=" << station);
 
-  for (uint32_t i = 0; i < m_nsupported; i++)
+  for (uint32_t i = 0; i < station->m_nsupported; i++)
     {
-      std::cout << "index(" << i << ") = " << m_minstrelTable[i].perfectTxTime << "\n";
+      std::cout << "index(" << i << ") = " << station->m_rates->perfectTxTime[i] << "\n";
     }
 }
 
@@ -27,54 +27,35 @@
 #include "wifi-mode.h"
 #include "ns3/nstime.h"
 #include "ns3/random-variable-stream.h"
+#include <map>
+#include <vector>
 
 namespace ns3 {
 
 struct MinstrelWifiRemoteStation;
 
 /**
- * A struct to contain all information related to a data rate
+ * Data structure for a Sample Rate table
+ * A vector of a vector uint32_t
+ */
+typedef std::vector<std::vector<uint32_t> > SampleRate;
+
+/**
+ * The part of the Minstrel tables which only depends on the supported
+ * rates of a station, and is shared by all the stations which support
+ * the same rates.
  */
-struct RateInfo
+struct MinstrelRateSet
 {
   /**
    * Perfect transmission time calculation, or frame calculation
    * Given a bit rate and a packet length n bytes
    */
-  Time perfectTxTime;
-
-
-  uint32_t retryCount;  ///< retry limit
-  uint32_t adjustedRetryCount;  ///< adjust the retry limit for this rate
-  uint32_t numRateAttempt;  ///< how many number of attempts so far
-  uint32_t numRateSuccess;    ///< number of successful pkts
-  uint32_t prob;  ///< (# pkts success )/(# total pkts)
-
-  /**
-   * EWMA calculation
-   * ewma_prob =[prob *(100 - ewma_level) + (ewma_prob_old * ewma_level)]/100
-   */
-  uint32_t ewmaProb;
-
-  uint32_t prevNumRateAttempt;  ///< from last rate
-  uint32_t prevNumRateSuccess;  ///< from last rate
-  uint64_t successHist;  ///< aggregate of all successes
-  uint64_t attemptHist;  ///< aggregate of all attempts
-  uint32_t throughput;  ///< throughput of a rate
+  std::vector<Time> perfectTxTime;
+  std::vector<uint32_t> retryCount;  ///< retry limit
+  SampleRate sampleTable;  ///< sample table
 };
 
-/**
- * Data structure for a Minstrel Rate table
- * A vector of a struct RateInfo
- */
-typedef std::vector<struct RateInfo> MinstrelRate;
-
-/**
- * Data structure for a Sample Rate table
- * A vector of a vector uint32_t
- */
-typedef std::vector<std::vector<uint32_t> > SampleRate;
-
 
 /**
  * \author Duy Nguyen
@@ -141,7 +122,10 @@ private:
   void RateInit (MinstrelWifiRemoteStation *station);
 
   /// initialize Sample Table
-  void InitSampleTable (MinstrelWifiRemoteStation *station);
+  void InitSampleTable (MinstrelRateSet *rates);
+
+  /// find or build the rate set shared by the stations with the same rates
+  const MinstrelRateSet * GetRateSet (MinstrelWifiRemoteStation *station);
 
   /// printing Sample Table
   void PrintSampleTable (MinstrelWifiRemoteStation *station);
@@ -153,8 +137,8 @@ private:
 
 
   typedef std::vector<std::pair<Time,WifiMode> > TxTime;
-  MinstrelRate m_minstrelTable;  ///< minstrel table
-  SampleRate m_sampleTable;  ///< sample table
+  /// the rate sets, indexed by the uids of their modes
+  typedef std::map<std::vector<uint32_t>, MinstrelRateSet> RateSets;
 
 
   TxTime m_calcTxTime;  ///< to hold all the calculated TxTime for all modes
@@ -164,7 +148,7 @@ private:
   uint32_t m_segmentSize;  ///< largest allowable segment size
   uint32_t m_sampleCol;  ///< number of sample columns
   uint32_t m_pktLen;  ///< packet length used  for calculate mode TxTime
-  uint32_t m_nsupported;  ///< modes supported
+  RateSets m_rateSets;  ///< the rate sets of the stations
 
   /// Provides uniform random variables.
   Ptr<UniformRandomVariable> m_uniformRandomVariable;
@@ -0,0 +1,123 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/assert.h"
+
+#include "nav-schedule.h"
+
+namespace ns3
+{
+
+NavSchedule::NavSchedule()
+{
+}
+
+void NavSchedule::Add(Time start, Time end)
+{
+	NS_ASSERT(start <= end);
+
+	// merge with the previous slot if it reaches start
+	Slots::iterator it = m_slots.upper_bound(start);
+	if (it != m_slots.begin())
+	{
+		Slots::iterator prev = it;
+		--prev;
+		if (prev->second >= start)
+		{
+			start = prev->first;
+			end = std::max(end, prev->second);
+			m_slots.erase(prev);
+		}
+	}
+
+	// merge with the following slots which begin before end
+	it = m_slots.lower_bound(start);
+	while (it != m_slots.end() && it->first <= end)
+	{
+		end = std::max(end, it->second);
+		m_slots.erase(it++);
+	}
+
+	m_slots[start] = end;
+}
+
+Time NavSchedule::FindFreeSlot(Time after, Time duration) const
+{
+	Time start = after;
+
+	// the slot which begins before start may still cover it
+	Slots::const_iterator it = m_slots.upper_bound(start);
+	if (it != m_slots.begin())
+	{
+		Slots::const_iterator prev = it;
+		--prev;
+		if (prev->second > start)
+		{
+			start = prev->second;
+		}
+	}
+
+	// skip the slots which do not leave enough room before them
+	while (it != m_slots.end() && it->first < start + duration)
+	{
+		start = std::max(start, it->second);
+		++it;
+	}
+	return start;
+}
+
+bool NavSchedule::IsFree(Time start, Time end) const
+{
+	// the last slot beginning before end is the only candidate
+	Slots::const_iterator it = m_slots.lower_bound(end);
+	if (it == m_slots.begin())
+	{
+		return true;
+	}
+	--it;
+	return it->second < start;
+}
+
+Time NavSchedule::GetEnd(void) const
+{
+	if (m_slots.empty())
+	{
+		return Seconds(0);
+	}
+	return m_slots.rbegin()->second;
+}
+
+uint32_t NavSchedule::GetN(void) const
+{
+	return m_slots.size();
+}
+
+void NavSchedule::Purge(Time now)
+{
+	// the slots never overlap, so their ends are ordered as their starts
+	Slots::iterator it = m_slots.begin();
+	while (it != m_slots.end() && it->second < now)
+	{
+		m_slots.erase(it++);
+	}
+}
+
+void NavSchedule::Clear(void)
+{
+	m_slots.clear();
+}
+
+} // namespace ns3
@@ -0,0 +1,94 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef NAV_SCHEDULE_H
+#define NAV_SCHEDULE_H
+
+#include <map>
+#include <stdint.h>
+#include "ns3/nstime.h"
+
+namespace ns3
+{
+
+/**
+ * \ingroup wifi
+ * \brief the timeline of the data channel reservations known by a
+ * data MAC.
+ *
+ * Every CTS sent or heard on the ctrl channel reserves a slot of the
+ * data channel, from the start announced by the CTS to the end of the
+ * ACK of the reserved transmission. The slots are kept ordered by start
+ * time and never overlap, so that a free slot can be found, or a slot
+ * checked, in O(log n) plus the number of slots skipped.
+ *
+ * A slot [start, end] may begin exactly at the end of the previous one:
+ * the reserved transmission itself only starts a SIFS later.
+ */
+class NavSchedule
+{
+public:
+	NavSchedule();
+
+	/**
+	 * \param start the start of the reservation
+	 * \param end the end of the reservation
+	 *
+	 * Add a reservation, merging it with the ones it overlaps.
+	 */
+	void Add(Time start, Time end);
+	/**
+	 * \param after the earliest acceptable start
+	 * \param duration the duration of the reservation
+	 * \returns the earliest start, not before after, of a slot of this
+	 * duration which does not overlap any reservation.
+	 */
+	Time FindFreeSlot(Time after, Time duration) const;
+	/**
+	 * \param start the start of the transmission
+	 * \param end the end of the transmission
+	 * \returns true if no reservation overlaps [start, end], a
+	 * reservation ending exactly at start included.
+	 */
+	bool IsFree(Time start, Time end) const;
+	/**
+	 * \returns the end of the last reservation, zero if there is none.
+	 */
+	Time GetEnd(void) const;
+	/**
+	 * \returns the number of reservations.
+	 */
+	uint32_t GetN(void) const;
+	/**
+	 * \param now the current time
+	 *
+	 * Forget the reservations which ended before now.
+	 */
+	void Purge(Time now);
+	/**
+	 * Forget all the reservations.
+	 */
+	void Clear(void);
+
+private:
+	/* start -> end */
+	typedef std::map<Time, Time> Slots;
+
+	Slots m_slots;
+};
+
+} // namespace ns3
+
+#endif /* NAV_SCHEDULE_H */
@@ -0,0 +1,42 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef RESERVATION_DROP_REASON_H
+#define RESERVATION_DROP_REASON_H
+
+namespace ns3 {
+
+/**
+ * \ingroup wifi
+ * The reason why a reservation of the data channel through the ctrl
+ * channel was given up.
+ */
+enum ReservationDropReason
+{
+  /** another station was granted the RTS opportunity of this frame */
+  RESERVATION_DROP_ARBITER,
+  /** the on-air frame ends before the RTS could be sent */
+  RESERVATION_DROP_LATE_RTS,
+  /** the on-air frame ends before the CTS could be sent */
+  RESERVATION_DROP_LATE_CTS,
+  /** the CTS overlaps a transmission or a reservation already known */
+  RESERVATION_DROP_INVALID_CTS,
+  /** the rest of a reserved burst could not be sent */
+  RESERVATION_DROP_BURST
+};
+
+} // namespace ns3
+
+#endif /* RESERVATION_DROP_REASON_H */
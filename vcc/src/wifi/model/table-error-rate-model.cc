@@ -0,0 +1,337 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include "table-error-rate-model.h"
+#include "nist-error-rate-model.h"
+#include "ns3/object-factory.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/string.h"
+#include "ns3/log.h"
+
+NS_LOG_COMPONENT_DEFINE ("TableErrorRateModel");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (TableErrorRateModel);
+
+/* the samples taken in each cell of the grid by GetMaxError */
+static const uint32_t ACCURACY_SAMPLES = 10;
+
+TypeId
+TableErrorRateModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::TableErrorRateModel")
+    .SetParent<ErrorRateModel> ()
+    .AddConstructor<TableErrorRateModel> ()
+    .AddAttribute ("Model",
+                   "The type of the error rate model to interpolate.",
+                   TypeIdValue (NistErrorRateModel::GetTypeId ()),
+                   MakeTypeIdAccessor (&TableErrorRateModel::SetModel,
+                                       &TableErrorRateModel::GetModel),
+                   MakeTypeIdChecker ())
+    .AddAttribute ("MinSnr",
+                   "The lowest SNR (dB) of the tables.",
+                   DoubleValue (-10.0),
+                   MakeDoubleAccessor (&TableErrorRateModel::SetMinSnr,
+                                       &TableErrorRateModel::GetMinSnr),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("MaxSnr",
+                   "The highest SNR (dB) of the tables.",
+                   DoubleValue (50.0),
+                   MakeDoubleAccessor (&TableErrorRateModel::SetMaxSnr,
+                                       &TableErrorRateModel::GetMaxSnr),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("Resolution",
+                   "The number of points of the tables per dB.",
+                   UintegerValue (20),
+                   MakeUintegerAccessor (&TableErrorRateModel::SetResolution,
+                                         &TableErrorRateModel::GetResolution),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("File",
+                   "A file written by TableErrorRateModel::Save to load the tables from, "
+                   "instead of building them. Empty to build all the tables.",
+                   StringValue (""),
+                   MakeStringAccessor (&TableErrorRateModel::SetFile,
+                                       &TableErrorRateModel::GetFile),
+                   MakeStringChecker ())
+  ;
+  return tid;
+}
+
+TableErrorRateModel::Tables &
+TableErrorRateModel::GetTables (void)
+{
+  // the tables of all the instances
+  static Tables tables;
+  return tables;
+}
+
+TableErrorRateModel::TableErrorRateModel ()
+{
+}
+
+TableErrorRateModel::~TableErrorRateModel ()
+{
+  m_model = 0;
+}
+
+void
+TableErrorRateModel::SetModel (TypeId tid)
+{
+  ObjectFactory factory;
+  factory.SetTypeId (tid);
+  m_model = factory.Create<ErrorRateModel> ();
+  m_modelTid = tid;
+  m_tables.clear ();
+}
+
+TypeId
+TableErrorRateModel::GetModel (void) const
+{
+  return m_modelTid;
+}
+
+void
+TableErrorRateModel::SetMinSnr (double minSnr)
+{
+  m_minSnr = minSnr;
+  // the tables of the old grid
+  m_tables.clear ();
+}
+
+double
+TableErrorRateModel::GetMinSnr (void) const
+{
+  return m_minSnr;
+}
+
+void
+TableErrorRateModel::SetMaxSnr (double maxSnr)
+{
+  m_maxSnr = maxSnr;
+  m_tables.clear ();
+}
+
+double
+TableErrorRateModel::GetMaxSnr (void) const
+{
+  return m_maxSnr;
+}
+
+void
+TableErrorRateModel::SetResolution (uint32_t resolution)
+{
+  m_resolution = resolution;
+  m_tables.clear ();
+}
+
+uint32_t
+TableErrorRateModel::GetResolution (void) const
+{
+  return m_resolution;
+}
+
+void
+TableErrorRateModel::SetFile (std::string filename)
+{
+  m_file = filename;
+  if (!filename.empty () && !Load (filename))
+    {
+      NS_LOG_WARN ("cannot load " << filename << ", the tables will be built");
+    }
+}
+
+std::string
+TableErrorRateModel::GetFile (void) const
+{
+  return m_file;
+}
+
+std::string
+TableErrorRateModel::GetKey (std::string model, std::string mode,
+                             double minSnr, double maxSnr, uint32_t resolution)
+{
+  std::ostringstream oss;
+  oss.precision (17);
+  oss << model << " " << mode << " " << minSnr << " " << maxSnr << " " << resolution;
+  return oss.str ();
+}
+
+void
+TableErrorRateModel::SetExponents (Table *table)
+{
+  table->exponent.resize (table->successRate.size ());
+  for (uint32_t i = 0; i < table->successRate.size (); i++)
+    {
+      // -inf where a bit is never lost, +inf where it is always lost
+      table->exponent[i] = std::log (-std::log (table->successRate[i]));
+    }
+}
+
+const TableErrorRateModel::Table *
+TableErrorRateModel::GetTable (WifiMode mode) const
+{
+  uint32_t uid = mode.GetUid ();
+  if (uid < m_tables.size () && m_tables[uid] != 0)
+    {
+      return m_tables[uid];
+    }
+
+  Tables &tables = GetTables ();
+  std::string key = GetKey (m_modelTid.GetName (), mode.GetUniqueName (),
+                            m_minSnr, m_maxSnr, m_resolution);
+  Tables::iterator it = tables.find (key);
+  if (it == tables.end ())
+    {
+      NS_ASSERT (m_maxSnr > m_minSnr);
+      Table table;
+      table.model = m_modelTid.GetName ();
+      table.mode = mode.GetUniqueName ();
+      table.minSnr = m_minSnr;
+      table.maxSnr = m_maxSnr;
+      table.resolution = m_resolution;
+      uint32_t n = (uint32_t)std::ceil ((m_maxSnr - m_minSnr) * m_resolution) + 1;
+      table.successRate.resize (n);
+      for (uint32_t i = 0; i < n; i++)
+        {
+          double snr = std::pow (10.0, (m_minSnr + (double)i / m_resolution) / 10.0);
+          table.successRate[i] = m_model->GetChunkSuccessRate (mode, snr, 1);
+        }
+      SetExponents (&table);
+      it = tables.insert (std::make_pair (key, table)).first;
+      NS_LOG_INFO ("built " << key << " max error for 1500 bytes "
+                            << GetMaxError (mode, 1500 * 8));
+    }
+
+  if (uid >= m_tables.size ())
+    {
+      m_tables.resize (uid + 1, 0);
+    }
+  m_tables[uid] = &it->second;
+  return m_tables[uid];
+}
+
+double
+TableErrorRateModel::GetChunkSuccessRate (WifiMode mode, double snr, uint32_t nbits) const
+{
+  const Table *table = GetTable (mode);
+  if (snr > 0)
+    {
+      double x = (10.0 * std::log10 (snr) - table->minSnr) * table->resolution;
+      if (x >= 0 && x < table->successRate.size () - 1)
+        {
+          uint32_t i = (uint32_t)x;
+          double lo = table->successRate[i];
+          double hi = table->successRate[i + 1];
+          if (lo == 1.0 && hi == 1.0)
+            {
+              return 1.0;
+            }
+          if (lo > 0.0 && lo < 1.0 && hi > 0.0 && hi < 1.0)
+            {
+              double exponent = table->exponent[i] + (x - i) * (table->exponent[i + 1] - table->exponent[i]);
+              return std::exp (-(double)nbits * std::exp (exponent));
+            }
+        }
+    }
+  return m_model->GetChunkSuccessRate (mode, snr, nbits);
+}
+
+double
+TableErrorRateModel::GetMaxError (WifiMode mode, uint32_t nbits) const
+{
+  const Table *table = GetTable (mode);
+  double maxError = 0.0;
+  for (uint32_t i = 0; i + 1 < table->successRate.size (); i++)
+    {
+      for (uint32_t k = 1; k < ACCURACY_SAMPLES; k++)
+        {
+          double snrDb = table->minSnr + (i + (double)k / ACCURACY_SAMPLES) / table->resolution;
+          double snr = std::pow (10.0, snrDb / 10.0);
+          double error = std::fabs (GetChunkSuccessRate (mode, snr, nbits)
+                                    - m_model->GetChunkSuccessRate (mode, snr, nbits));
+          maxError = std::max (maxError, error);
+        }
+    }
+  return maxError;
+}
+
+bool
+TableErrorRateModel::Save (std::string filename) const
+{
+  std::ofstream os (filename.c_str ());
+  if (!os.is_open ())
+    {
+      return false;
+    }
+  os.precision (17);
+  Tables &tables = GetTables ();
+  for (Tables::const_iterator it = tables.begin (); it != tables.end (); ++it)
+    {
+      const Table &table = it->second;
+      if (table.model != m_modelTid.GetName () || table.minSnr != m_minSnr
+          || table.maxSnr != m_maxSnr || table.resolution != m_resolution)
+        {
+          continue;
+        }
+      os << table.model << " " << table.mode << " " << table.minSnr << " "
+         << table.maxSnr << " " << table.resolution << " " << table.successRate.size ();
+      for (uint32_t i = 0; i < table.successRate.size (); i++)
+        {
+          os << ((i % 8) == 0 ? "\n" : " ") << table.successRate[i];
+        }
+      os << std::endl;
+    }
+  return !os.fail ();
+}
+
+bool
+TableErrorRateModel::Load (std::string filename)
+{
+  std::ifstream is (filename.c_str ());
+  if (!is.is_open ())
+    {
+      return false;
+    }
+  Tables &tables = GetTables ();
+  Table table;
+  uint32_t n;
+  while (is >> table.model >> table.mode >> table.minSnr >> table.maxSnr >> table.resolution >> n)
+    {
+      table.successRate.resize (n);
+      for (uint32_t i = 0; i < n; i++)
+        {
+          if (!(is >> table.successRate[i]))
+            {
+              return false;
+            }
+        }
+      std::string key = GetKey (table.model, table.mode, table.minSnr,
+                                table.maxSnr, table.resolution);
+      if (tables.find (key) == tables.end ())
+        {
+          SetExponents (&table);
+          tables.insert (std::make_pair (key, table));
+        }
+    }
+  return is.eof ();
+}
+
+} // namespace ns3
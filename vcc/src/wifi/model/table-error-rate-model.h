@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef TABLE_ERROR_RATE_MODEL_H
+#define TABLE_ERROR_RATE_MODEL_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+#include "wifi-mode.h"
+#include "error-rate-model.h"
+#include "ns3/type-id.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup wifi
+ * \brief an error rate model which interpolates another model from
+ *        precomputed tables.
+ *
+ * The chunk success rate of the Nist, Yans and DSSS models is the
+ * success rate of a single bit raised to the power nbits. For every
+ * WifiMode, this model samples the log of the per bit error exponent,
+ * log (-log (GetChunkSuccessRate (mode, snr, 1))), of the underlying
+ * model on a grid of SNR in dB and interpolates it linearly, so that
+ * a chunk costs a log10 and two exp instead of an erfc and a
+ * polynomial. Outside of the grid, and where the exponent is not
+ * finite, the underlying model is called.
+ *
+ * A table is built the first time its mode is used. Tables are shared
+ * by all the instances which use the same type of underlying model and
+ * the same grid, hence the underlying model must not keep any per
+ * instance state. They can also be loaded from a file written by Save,
+ * see utils/error-rate-table.cc, which also reports the accuracy of
+ * the tables against the closed form.
+ */
+class TableErrorRateModel : public ErrorRateModel
+{
+public:
+  static TypeId GetTypeId (void);
+
+  TableErrorRateModel ();
+  virtual ~TableErrorRateModel ();
+
+  virtual double GetChunkSuccessRate (WifiMode mode, double snr, uint32_t nbits) const;
+
+  /**
+   * \param mode the mode to check
+   * \param nbits the number of bits of the chunks to check
+   * \returns the largest absolute difference between the interpolated
+   *          and the exact chunk success rate, sampled in between the
+   *          points of the grid.
+   */
+  double GetMaxError (WifiMode mode, uint32_t nbits) const;
+  /**
+   * \param filename the file to write
+   * \returns true if the file could be written, false otherwise.
+   *
+   * Write all the tables built so far for the underlying model and the
+   * grid of this instance.
+   */
+  bool Save (std::string filename) const;
+  /**
+   * \param filename a file written by Save
+   * \returns true if the file could be read, false otherwise.
+   *
+   * Make the tables of the file available to all the instances which
+   * use the same underlying model and grid. Tables already built are
+   * kept.
+   */
+  static bool Load (std::string filename);
+
+private:
+  struct Table
+  {
+    std::string model;
+    std::string mode;
+    double minSnr;
+    double maxSnr;
+    uint32_t resolution;
+    /* per bit success rate, at each point of the grid */
+    std::vector<double> successRate;
+    /* log of the per bit error exponent, at each point of the grid */
+    std::vector<double> exponent;
+  };
+  typedef std::map<std::string, Table> Tables;
+
+  void SetModel (TypeId tid);
+  TypeId GetModel (void) const;
+  void SetMinSnr (double minSnr);
+  double GetMinSnr (void) const;
+  void SetMaxSnr (double maxSnr);
+  double GetMaxSnr (void) const;
+  void SetResolution (uint32_t resolution);
+  uint32_t GetResolution (void) const;
+  void SetFile (std::string filename);
+  std::string GetFile (void) const;
+  const Table * GetTable (WifiMode mode) const;
+  static std::string GetKey (std::string model, std::string mode,
+                             double minSnr, double maxSnr, uint32_t resolution);
+  static void SetExponents (Table *table);
+  static Tables & GetTables (void);
+
+  Ptr<ErrorRateModel> m_model;
+  TypeId m_modelTid;
+  double m_minSnr;
+  double m_maxSnr;
+  uint32_t m_resolution;
+  std::string m_file;
+  /* tables indexed by the uid of their mode */
+  mutable std::vector<const Table *> m_tables;
+};
+
+} // namespace ns3
+
+#endif /* TABLE_ERROR_RATE_MODEL_H */
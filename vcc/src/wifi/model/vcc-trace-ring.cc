@@ -0,0 +1,327 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <fstream>
+#include <cstring>
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+#include "ns3/simulator.h"
+
+#include "vcc-trace-ring.h"
+#include "wifi-net-device.h"
+#include "regular-data-wifi-mac.h"
+#include "regular-ctrl-wifi-mac.h"
+#include "data-dca-txop.h"
+#include "ctrl-dca-txop.h"
+
+NS_LOG_COMPONENT_DEFINE("VccTraceRing");
+
+namespace ns3
+{
+
+/* file layout: header, then the records field by field in host byte order */
+static const char g_magic[4] =
+{ 'V', 'C', 'C', 'T' };
+static const uint32_t g_version = 1;
+static const uint32_t g_recordSize = 38;
+
+NS_OBJECT_ENSURE_REGISTERED(VccTraceRing);
+
+TypeId VccTraceRing::GetTypeId(void)
+{
+	static TypeId tid = TypeId("ns3::VccTraceRing").SetParent<Object>()
+			.AddConstructor<VccTraceRing>()
+			.AddAttribute("Capacity",
+					"The number of records kept, rounded up to a power of two.",
+					UintegerValue(65536),
+					MakeUintegerAccessor(&VccTraceRing::SetCapacity,
+							&VccTraceRing::GetCapacity),
+					MakeUintegerChecker<uint32_t>(1, 1u << 31));
+	return tid;
+}
+
+VccTraceRing::VccTraceRing() :
+		m_head(0), m_mask(0)
+{
+	NS_LOG_FUNCTION (this);
+	SetCapacity(1);
+}
+
+VccTraceRing::~VccTraceRing()
+{
+	NS_LOG_FUNCTION (this);
+}
+
+void VccTraceRing::Install(NodeContainer c)
+{
+	for (NodeContainer::Iterator i = c.Begin(); i != c.End(); ++i)
+	{
+		Install(*i);
+	}
+}
+
+void VccTraceRing::Install(Ptr<Node> node)
+{
+	NS_LOG_FUNCTION (this << node);
+
+	Ptr<RegularDataWifiMac> dataMac;
+	Ptr<RegularCtrlWifiMac> ctrlMac;
+	for (uint32_t i = 0; i < node->GetNDevices(); ++i)
+	{
+		Ptr<WifiNetDevice> device = DynamicCast<WifiNetDevice>(
+				node->GetDevice(i));
+		if (device == 0)
+		{
+			continue;
+		}
+
+		Ptr<WifiMac> mac = device->GetMac();
+		if (DynamicCast<RegularDataWifiMac>(mac) != 0)
+		{
+			dataMac = DynamicCast<RegularDataWifiMac>(mac);
+		}
+		else if (DynamicCast<RegularCtrlWifiMac>(mac) != 0)
+		{
+			ctrlMac = DynamicCast<RegularCtrlWifiMac>(mac);
+		}
+	}
+
+	if (dataMac == 0 || ctrlMac == 0)
+	{
+		NS_LOG_WARN("node " << node->GetId ()
+				<< " does not own both a data and a ctrl device, ignore it");
+		return;
+	}
+
+	// a node is known by its data address in all the records
+	Mac48Address self = dataMac->GetAddress();
+	Ptr<DataDcaTxop> dataDca = dataMac->m_dca;
+	Ptr<CtrlDcaTxop> ctrlDca = ctrlMac->m_dca;
+	ctrlDca->TraceConnectWithoutContext("RtsEnqueued",
+			MakeCallback(&VccTraceRing::NotifyRtsEnqueued, this).Bind(self));
+	ctrlDca->TraceConnectWithoutContext("ReservationDropped",
+			MakeCallback(&VccTraceRing::NotifyReservationDropped, this).Bind(
+					self));
+	dataDca->TraceConnectWithoutContext("CtsGranted",
+			MakeCallback(&VccTraceRing::NotifyCtsGranted, this).Bind(self));
+	dataDca->TraceConnectWithoutContext("NavScheduled",
+			MakeCallback(&VccTraceRing::NotifyNavScheduled, this).Bind(self));
+	dataDca->TraceConnectWithoutContext("ReservationDropped",
+			MakeCallback(&VccTraceRing::NotifyReservationDropped, this).Bind(
+					self));
+}
+
+void VccTraceRing::SetCapacity(uint32_t capacity)
+{
+	uint32_t size = 1;
+	while (size < capacity)
+	{
+		size <<= 1;
+	}
+	m_records.clear();
+	m_records.resize(size);
+	m_mask = size - 1;
+	m_head = 0;
+}
+
+uint32_t VccTraceRing::GetCapacity(void) const
+{
+	return m_records.size();
+}
+
+uint64_t VccTraceRing::GetNRecorded(void) const
+{
+	return m_head;
+}
+
+uint32_t VccTraceRing::GetN(void) const
+{
+	if (m_head < m_records.size())
+	{
+		return m_head;
+	}
+	return m_records.size();
+}
+
+const VccTraceRing::Record &
+VccTraceRing::Get(uint32_t i) const
+{
+	NS_ASSERT(i < GetN());
+	uint64_t first = m_head - GetN();
+	return m_records[(first + i) & m_mask];
+}
+
+void VccTraceRing::Clear(void)
+{
+	m_head = 0;
+}
+
+VccTraceRing::Record &
+VccTraceRing::Next(Event event, Mac48Address self, Mac48Address peer)
+{
+	Record &record = m_records[m_head & m_mask];
+	++m_head;
+	record.time = Simulator::Now().GetNanoSeconds();
+	record.event = event;
+	record.reason = 0;
+	self.CopyTo(record.self);
+	peer.CopyTo(record.peer);
+	record.start = 0;
+	record.duration = 0;
+	return record;
+}
+
+void VccTraceRing::NotifyRtsEnqueued(Mac48Address self,
+		const WifiMacHeader &rtsHdr)
+{
+	Record &record = Next(RTS_ENQUEUED, self, rtsHdr.GetAddr1());
+	record.duration = rtsHdr.GetDuration().GetNanoSeconds();
+}
+
+void VccTraceRing::NotifyCtsGranted(Mac48Address self,
+		const WifiMacHeader &ctsHdr, Time start)
+{
+	Record &record = Next(CTS_GRANTED, self, ctsHdr.GetAddr1());
+	record.start = start.GetNanoSeconds();
+	record.duration = ctsHdr.GetDuration().GetNanoSeconds();
+}
+
+void VccTraceRing::NotifyNavScheduled(Mac48Address self, Mac48Address owner,
+		Time start, Time duration)
+{
+	Record &record = Next(NAV_SCHEDULED, self, owner);
+	record.start = start.GetNanoSeconds();
+	record.duration = duration.GetNanoSeconds();
+}
+
+void VccTraceRing::NotifyReservationDropped(Mac48Address self,
+		Mac48Address peer, ReservationDropReason reason)
+{
+	Record &record = Next(RESERVATION_DROPPED, self, peer);
+	record.reason = reason;
+}
+
+void VccTraceRing::Write(std::ostream &os) const
+{
+	uint64_t n = GetN();
+	os.write(g_magic, sizeof(g_magic));
+	os.write((const char *) &g_version, sizeof(g_version));
+	os.write((const char *) &g_recordSize, sizeof(g_recordSize));
+	os.write((const char *) &n, sizeof(n));
+	for (uint32_t i = 0; i < n; ++i)
+	{
+		const Record &record = Get(i);
+		os.write((const char *) &record.time, sizeof(record.time));
+		os.write((const char *) &record.event, sizeof(record.event));
+		os.write((const char *) &record.reason, sizeof(record.reason));
+		os.write((const char *) record.self, sizeof(record.self));
+		os.write((const char *) record.peer, sizeof(record.peer));
+		os.write((const char *) &record.start, sizeof(record.start));
+		os.write((const char *) &record.duration, sizeof(record.duration));
+	}
+}
+
+bool VccTraceRing::Write(std::string filename) const
+{
+	std::ofstream os(filename.c_str(), std::ios::out | std::ios::binary);
+	if (!os.is_open())
+	{
+		NS_LOG_ERROR("can not open " << filename);
+		return false;
+	}
+	Write(os);
+	return os.good();
+}
+
+bool VccTraceRing::Read(std::istream &is, std::vector<Record> &records)
+{
+	char magic[4];
+	uint32_t version;
+	uint32_t recordSize;
+	uint64_t n;
+	is.read(magic, sizeof(magic));
+	is.read((char *) &version, sizeof(version));
+	is.read((char *) &recordSize, sizeof(recordSize));
+	is.read((char *) &n, sizeof(n));
+	if (!is.good() || std::memcmp(magic, g_magic, sizeof(magic)) != 0
+			|| version != g_version || recordSize != g_recordSize)
+	{
+		return false;
+	}
+
+	for (uint64_t i = 0; i < n; ++i)
+	{
+		Record record;
+		is.read((char *) &record.time, sizeof(record.time));
+		is.read((char *) &record.event, sizeof(record.event));
+		is.read((char *) &record.reason, sizeof(record.reason));
+		is.read((char *) record.self, sizeof(record.self));
+		is.read((char *) record.peer, sizeof(record.peer));
+		is.read((char *) &record.start, sizeof(record.start));
+		is.read((char *) &record.duration, sizeof(record.duration));
+		if (!is.good())
+		{
+			return false;
+		}
+		records.push_back(record);
+	}
+	return true;
+}
+
+bool VccTraceRing::Decode(std::istream &is, std::ostream &os)
+{
+	std::vector<Record> records;
+	bool ok = Read(is, records);
+	for (std::vector<Record>::const_iterator i = records.begin();
+			i != records.end(); ++i)
+	{
+		Print(*i, os);
+	}
+	return ok;
+}
+
+void VccTraceRing::Print(const Record &record, std::ostream &os)
+{
+	static const char *events[] =
+	{ "UNKNOWN", "RTS_ENQUEUED", "CTS_GRANTED", "NAV_SCHEDULED",
+			"RESERVATION_DROPPED" };
+	static const char *reasons[] =
+	{ "ARBITER", "LATE_RTS", "LATE_CTS", "INVALID_CTS", "BURST" };
+
+	Mac48Address self;
+	Mac48Address peer;
+	self.CopyFrom(record.self);
+	peer.CopyFrom(record.peer);
+
+	os << record.time << "ns "
+			<< events[record.event <= RESERVATION_DROPPED ? record.event : 0]
+			<< " self=" << self << " peer=" << peer;
+	if (record.event == RESERVATION_DROPPED)
+	{
+		os << " reason="
+				<< (record.reason <= RESERVATION_DROP_BURST ?
+						reasons[record.reason] : "UNKNOWN");
+	}
+	else
+	{
+		os << " start=" << record.start << "ns duration=" << record.duration
+				<< "ns";
+	}
+	os << std::endl;
+}
+
+} // namespace ns3
@@ -0,0 +1,158 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef VCC_TRACE_RING_H
+#define VCC_TRACE_RING_H
+
+#include <stdint.h>
+#include <vector>
+#include <string>
+#include <istream>
+#include <ostream>
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/node.h"
+#include "ns3/node-container.h"
+#include "ns3/mac48-address.h"
+#include "ns3/wifi-mac-header.h"
+#include "ns3/reservation-drop-reason.h"
+
+namespace ns3
+{
+
+/**
+ * \ingroup wifi
+ * \brief binary trace of the virtual control channel events.
+ *
+ * Every RTS queued on the ctrl channel, every CTS granted, every data
+ * channel reservation learnt and every reservation given up is stored
+ * as a fixed size record in a ring buffer which is allocated once: when
+ * it is full, the oldest records are overwritten. Recording an event
+ * costs a few stores and no formatting, so the trace can stay enabled
+ * in optimized runs where NS_LOG is compiled out. The records are
+ * written in a binary file by Write and turned into text offline by
+ * Decode (see utils/vcc-trace-decode.cc).
+ *
+ * The simulator is single threaded and the ring has a single writer,
+ * so it needs no lock.
+ */
+class VccTraceRing: public Object
+{
+public:
+	enum Event
+	{
+		RTS_ENQUEUED = 1,
+		CTS_GRANTED,
+		NAV_SCHEDULED,
+		RESERVATION_DROPPED
+	};
+
+	struct Record
+	{
+		int64_t time; // ns
+		uint8_t event;
+		uint8_t reason; // ReservationDropReason of a RESERVATION_DROPPED
+		uint8_t self[6]; // data address of the station which records
+		uint8_t peer[6]; // data address of the other station
+		int64_t start; // ns, start of the reserved slot
+		int64_t duration; // ns
+	};
+
+	static TypeId GetTypeId(void);
+
+	VccTraceRing();
+	virtual ~VccTraceRing();
+
+	/**
+	 * \param c the set of nodes to trace
+	 *
+	 * Call Install (Ptr<Node>) on every node of the container.
+	 */
+	void Install(NodeContainer c);
+	/**
+	 * \param node the node to trace
+	 *
+	 * Connect the trace sources of the data and ctrl txops of this node.
+	 * Nodes which do not have both kinds of devices are ignored.
+	 */
+	void Install(Ptr<Node> node);
+
+	/**
+	 * \param capacity the number of records kept, rounded up to a power
+	 * of two. The records already stored are discarded.
+	 */
+	void SetCapacity(uint32_t capacity);
+	uint32_t GetCapacity(void) const;
+
+	/**
+	 * \returns the number of records stored since the last Clear,
+	 * including the overwritten ones.
+	 */
+	uint64_t GetNRecorded(void) const;
+	/**
+	 * \returns the number of records kept in the ring.
+	 */
+	uint32_t GetN(void) const;
+	/**
+	 * \param i index of a record, 0 is the oldest one kept
+	 * \returns the record.
+	 */
+	const Record & Get(uint32_t i) const;
+	void Clear(void);
+
+	/**
+	 * \param os the stream to write the records kept to, oldest first
+	 */
+	void Write(std::ostream &os) const;
+	/**
+	 * \param filename the file to write the records kept to
+	 * \returns true if the file could be written.
+	 */
+	bool Write(std::string filename) const;
+
+	/**
+	 * \param is a stream written by Write
+	 * \param records the records read from the stream
+	 * \returns true if the stream is a complete trace.
+	 */
+	static bool Read(std::istream &is, std::vector<Record> &records);
+	/**
+	 * \param is a stream written by Write
+	 * \param os the stream to print one line per record to
+	 * \returns true if the stream is a complete trace.
+	 */
+	static bool Decode(std::istream &is, std::ostream &os);
+	static void Print(const Record &record, std::ostream &os);
+
+	/* sinks of the txop trace sources, the first argument is bound by Install */
+	void NotifyRtsEnqueued(Mac48Address self, const WifiMacHeader &rtsHdr);
+	void NotifyCtsGranted(Mac48Address self, const WifiMacHeader &ctsHdr,
+			Time start);
+	void NotifyNavScheduled(Mac48Address self, Mac48Address owner, Time start,
+			Time duration);
+	void NotifyReservationDropped(Mac48Address self, Mac48Address peer,
+			ReservationDropReason reason);
+
+private:
+	Record & Next(Event event, Mac48Address self, Mac48Address peer);
+
+	std::vector<Record> m_records;
+	uint64_t m_head;
+	uint32_t m_mask;
+};
+
+} // namespace ns3
+
+#endif /* VCC_TRACE_RING_H */
@@ -23,6 +23,7 @@
 #include "ns3/simulator.h"
 #include "ns3/packet.h"
 #include "ns3/uinteger.h"
+#include "ns3/trace-source-accessor.h"
 
 #include "wifi-mac-queue.h"
 #include "qos-blocked-destinations.h"
@@ -31,12 +32,12 @@ namespace ns3 {
 
 NS_OBJECT_ENSURE_REGISTERED (WifiMacQueue);
 
-WifiMacQueue::Item::Item (Ptr<const Packet> packet,
-                          const WifiMacHeader &hdr,
-                          Time tstamp)
-  : packet (packet),
-    hdr (hdr),
-    tstamp (tstamp)
+const uint32_t WifiMacQueue::NONE;
+
+WifiMacQueue::Chain::Chain ()
+  : head (NONE),
+    tail (NONE),
+    n (0)
 {
 }
 
@@ -54,12 +55,17 @@ WifiMacQueue::GetTypeId (void)
                    TimeValue (Seconds (10.0)),
                    MakeTimeAccessor (&WifiMacQueue::m_maxDelay),
                    MakeTimeChecker ())
+    .AddTraceSource ("Depth", "The number of packets in the queue.",
+                     MakeTraceSourceAccessor (&WifiMacQueue::m_size))
+    .AddTraceSource ("Sojourn", "A packet leaves the queue to be transmitted, after the given time in the queue.",
+                     MakeTraceSourceAccessor (&WifiMacQueue::m_sojournTrace))
   ;
   return tid;
 }
 
 WifiMacQueue::WifiMacQueue ()
-  : m_size (0)
+  : m_free (NONE),
+    m_size (0)
 {
 }
 
@@ -93,54 +99,169 @@ WifiMacQueue::GetMaxDelay (void) const
 }
 
 void
-WifiMacQueue::Enqueue (Ptr<const Packet> packet, const WifiMacHeader &hdr)
+WifiMacQueue::Attach (Chain &chain, enum Link link, uint32_t i, bool front)
 {
-  Cleanup ();
-  if (m_size == m_maxSize)
+  Item &item = m_items[i];
+  if (front)
     {
-      return;
+      item.prev[link] = NONE;
+      item.next[link] = chain.head;
+      if (chain.head != NONE)
+        {
+          m_items[chain.head].prev[link] = i;
+        }
+      else
+        {
+          chain.tail = i;
+        }
+      chain.head = i;
+    }
+  else
+    {
+      item.prev[link] = chain.tail;
+      item.next[link] = NONE;
+      if (chain.tail != NONE)
+        {
+          m_items[chain.tail].next[link] = i;
+        }
+      else
+        {
+          chain.head = i;
+        }
+      chain.tail = i;
+    }
+  chain.n++;
+}
+
+void
+WifiMacQueue::Detach (Chain &chain, enum Link link, uint32_t i)
+{
+  Item &item = m_items[i];
+  if (item.prev[link] != NONE)
+    {
+      m_items[item.prev[link]].next[link] = item.next[link];
+    }
+  else
+    {
+      chain.head = item.next[link];
+    }
+  if (item.next[link] != NONE)
+    {
+      m_items[item.next[link]].prev[link] = item.prev[link];
+    }
+  else
+    {
+      chain.tail = item.prev[link];
+    }
+  chain.n--;
+}
+
+void
+WifiMacQueue::Insert (Ptr<const Packet> packet, const WifiMacHeader &hdr, bool front)
+{
+  uint32_t i = m_free;
+  if (i != NONE)
+    {
+      m_free = m_items[i].next[QUEUE];
+    }
+  else
+    {
+      i = m_items.size ();
+      m_items.push_back (Item ());
+    }
+  Item &item = m_items[i];
+  item.packet = packet;
+  item.hdr = hdr;
+  item.tstamp = Simulator::Now ();
+
+  // every packet is stamped with the current time, so the order of
+  // arrival is also the order of expiry, even for PushFront
+  Attach (m_queue, QUEUE, i, front);
+  Attach (m_arrival, ARRIVAL, i, false);
+  Attach (m_receivers[hdr.GetAddr1 ()], RECEIVER, i, front);
+  if (hdr.IsQosData ())
+    {
+      Mac48AddressTid key;
+      key.address = hdr.GetAddr1 ();
+      key.tid = hdr.GetQosTid ();
+      Attach (m_tids[key], RECEIVER_TID, i, front);
     }
-  Time now = Simulator::Now ();
-  m_queue.push_back (Item (packet, hdr, now));
   m_size++;
 }
 
 void
-WifiMacQueue::Cleanup (void)
+WifiMacQueue::Erase (uint32_t i, bool sent)
 {
-  if (m_queue.empty ())
+  Item &item = m_items[i];
+  if (sent)
+    {
+      m_sojournTrace (item.packet, Simulator::Now () - item.tstamp);
+    }
+  Detach (m_queue, QUEUE, i);
+  Detach (m_arrival, ARRIVAL, i);
+  ReceiverChains::iterator receiver = m_receivers.find (item.hdr.GetAddr1 ());
+  Detach (receiver->second, RECEIVER, i);
+  if (receiver->second.n == 0)
+    {
+      m_receivers.erase (receiver);
+    }
+  if (item.hdr.IsQosData ())
+    {
+      Mac48AddressTid key;
+      key.address = item.hdr.GetAddr1 ();
+      key.tid = item.hdr.GetQosTid ();
+      TidChains::iterator tid = m_tids.find (key);
+      Detach (tid->second, RECEIVER_TID, i);
+      if (tid->second.n == 0)
+        {
+          m_tids.erase (tid);
+        }
+    }
+  item.packet = 0;
+  item.next[QUEUE] = m_free;
+  m_free = i;
+  m_size--;
+}
+
+Ptr<const Packet>
+WifiMacQueue::Get (uint32_t i, WifiMacHeader *hdr) const
+{
+  *hdr = m_items[i].hdr;
+  return m_items[i].packet;
+}
+
+void
+WifiMacQueue::Enqueue (Ptr<const Packet> packet, const WifiMacHeader &hdr)
+{
+  Cleanup ();
+  if (m_size == m_maxSize)
     {
       return;
     }
+  Insert (packet, hdr, false);
+}
 
+void
+WifiMacQueue::Cleanup (void)
+{
   Time now = Simulator::Now ();
-  uint32_t n = 0;
-  for (PacketQueueI i = m_queue.begin (); i != m_queue.end ();)
+  while (m_arrival.head != NONE
+         && m_items[m_arrival.head].tstamp + m_maxDelay <= now)
     {
-      if (i->tstamp + m_maxDelay > now)
-        {
-          i++;
-        }
-      else
-        {
-          i = m_queue.erase (i);
-          n++;
-        }
+      Erase (m_arrival.head, false);
     }
-  m_size -= n;
 }
 
 Ptr<const Packet>
 WifiMacQueue::Dequeue (WifiMacHeader *hdr)
 {
   Cleanup ();
-  if (!m_queue.empty ())
+  if (m_queue.head != NONE)
     {
-      Item i = m_queue.front ();
-      m_queue.pop_front ();
-      m_size--;
-      *hdr = i.hdr;
-      return i.packet;
+      uint32_t i = m_queue.head;
+      Ptr<const Packet> packet = Get (i, hdr);
+      Erase (i, true);
+      return packet;
     }
   return 0;
 }
@@ -149,42 +270,56 @@ Ptr<const Packet>
 WifiMacQueue::Peek (WifiMacHeader *hdr)
 {
   Cleanup ();
-  if (!m_queue.empty ())
+  if (m_queue.head != NONE)
     {
-      Item i = m_queue.front ();
-      *hdr = i.hdr;
-      return i.packet;
+      return Get (m_queue.head, hdr);
     }
   return 0;
 }
 
+uint32_t
+WifiMacQueue::Find (WifiMacHeader::AddressType type, Mac48Address addr,
+                    bool qosTid, uint8_t tid) const
+{
+  NS_ASSERT (type <= 4);
+  if (type == WifiMacHeader::ADDR1)
+    {
+      if (qosTid)
+        {
+          Mac48AddressTid key;
+          key.address = addr;
+          key.tid = tid;
+          TidChains::const_iterator it = m_tids.find (key);
+          return it != m_tids.end () ? it->second.head : NONE;
+        }
+      ReceiverChains::const_iterator it = m_receivers.find (addr);
+      return it != m_receivers.end () ? it->second.head : NONE;
+    }
+  for (uint32_t i = m_queue.head; i != NONE; i = m_items[i].next[QUEUE])
+    {
+      const Item &item = m_items[i];
+      if (GetAddressForPacket (type, item) == addr
+          && (!qosTid || (item.hdr.IsQosData () && item.hdr.GetQosTid () == tid)))
+        {
+          return i;
+        }
+    }
+  return NONE;
+}
+
 Ptr<const Packet>
 WifiMacQueue::DequeueByTidAndAddress (WifiMacHeader *hdr, uint8_t tid,
                                       WifiMacHeader::AddressType type, Mac48Address dest)
 {
   Cleanup ();
-  Ptr<const Packet> packet = 0;
-  if (!m_queue.empty ())
+  uint32_t i = Find (type, dest, true, tid);
+  if (i != NONE)
     {
-      PacketQueueI it;
-      NS_ASSERT (type <= 4);
-      for (it = m_queue.begin (); it != m_queue.end (); ++it)
-        {
-          if (it->hdr.IsQosData ())
-            {
-              if (GetAddressForPacket (type, it) == dest
-                  && it->hdr.GetQosTid () == tid)
-                {
-                  packet = it->packet;
-                  *hdr = it->hdr;
-                  m_queue.erase (it);
-                  m_size--;
-                  break;
-                }
-            }
-        }
+      Ptr<const Packet> packet = Get (i, hdr);
+      Erase (i, true);
+      return packet;
     }
-  return packet;
+  return 0;
 }
 
 Ptr<const Packet>
@@ -192,31 +327,65 @@ WifiMacQueue::PeekByTidAndAddress (WifiMacHeader *hdr, uint8_t tid,
                                    WifiMacHeader::AddressType type, Mac48Address dest)
 {
   Cleanup ();
-  if (!m_queue.empty ())
+  uint32_t i = Find (type, dest, true, tid);
+  if (i != NONE)
     {
-      PacketQueueI it;
-      NS_ASSERT (type <= 4);
-      for (it = m_queue.begin (); it != m_queue.end (); ++it)
+      return Get (i, hdr);
+    }
+  return 0;
+}
+
+Ptr<const Packet>
+WifiMacQueue::DequeueByAddress (WifiMacHeader *hdr,
+                                WifiMacHeader::AddressType type, Mac48Address dest)
+{
+  Cleanup ();
+  uint32_t i = Find (type, dest, false, 0);
+  if (i != NONE)
+    {
+      Ptr<const Packet> packet = Get (i, hdr);
+      Erase (i, true);
+      return packet;
+    }
+  return 0;
+}
+
+uint32_t
+WifiMacQueue::PeekByAddress (std::vector<Ptr<const Packet> > &packets,
+                             std::vector<WifiMacHeader> &hdrs,
+                             WifiMacHeader::AddressType type, Mac48Address dest,
+                             uint32_t maxN)
+{
+  Cleanup ();
+  uint32_t n = 0;
+  if (type == WifiMacHeader::ADDR1)
+    {
+      for (uint32_t i = Find (type, dest, false, 0); i != NONE && n < maxN; i = m_items[i].next[RECEIVER])
         {
-          if (it->hdr.IsQosData ())
-            {
-              if (GetAddressForPacket (type, it) == dest
-                  && it->hdr.GetQosTid () == tid)
-                {
-                  *hdr = it->hdr;
-                  return it->packet;
-                }
-            }
+          packets.push_back (m_items[i].packet);
+          hdrs.push_back (m_items[i].hdr);
+          n++;
         }
+      return n;
     }
-  return 0;
+  NS_ASSERT (type <= 4);
+  for (uint32_t i = m_queue.head; i != NONE && n < maxN; i = m_items[i].next[QUEUE])
+    {
+      if (GetAddressForPacket (type, m_items[i]) == dest)
+        {
+          packets.push_back (m_items[i].packet);
+          hdrs.push_back (m_items[i].hdr);
+          n++;
+        }
+    }
+  return n;
 }
 
 bool
 WifiMacQueue::IsEmpty (void)
 {
   Cleanup ();
-  return m_queue.empty ();
+  return m_queue.head == NONE;
 }
 
 uint32_t
@@ -228,24 +397,29 @@ WifiMacQueue::GetSize (void)
 void
 WifiMacQueue::Flush (void)
 {
-  m_queue.erase (m_queue.begin (), m_queue.end ());
+  m_items.clear ();
+  m_free = NONE;
+  m_queue = Chain ();
+  m_arrival = Chain ();
+  m_receivers.clear ();
+  m_tids.clear ();
   m_size = 0;
 }
 
 Mac48Address
-WifiMacQueue::GetAddressForPacket (enum WifiMacHeader::AddressType type, PacketQueueI it)
+WifiMacQueue::GetAddressForPacket (enum WifiMacHeader::AddressType type, const Item &item) const
 {
   if (type == WifiMacHeader::ADDR1)
     {
-      return it->hdr.GetAddr1 ();
+      return item.hdr.GetAddr1 ();
     }
   if (type == WifiMacHeader::ADDR2)
     {
-      return it->hdr.GetAddr2 ();
+      return item.hdr.GetAddr2 ();
     }
   if (type == WifiMacHeader::ADDR3)
     {
-      return it->hdr.GetAddr3 ();
+      return item.hdr.GetAddr3 ();
     }
   return 0;
 }
@@ -253,13 +427,11 @@ WifiMacQueue::GetAddressForPacket (enum WifiMacHeader::AddressType type, PacketQ
 bool
 WifiMacQueue::Remove (Ptr<const Packet> packet)
 {
-  PacketQueueI it = m_queue.begin ();
-  for (; it != m_queue.end (); it++)
+  for (uint32_t i = m_queue.head; i != NONE; i = m_items[i].next[QUEUE])
     {
-      if (it->packet == packet)
+      if (m_items[i].packet == packet)
         {
-          m_queue.erase (it);
-          m_size--;
+          Erase (i, true);
           return true;
         }
     }
@@ -274,9 +446,7 @@ WifiMacQueue::PushFront (Ptr<const Packet> packet, const WifiMacHeader &hdr)
     {
       return;
     }
-  Time now = Simulator::Now ();
-  m_queue.push_front (Item (packet, hdr, now));
-  m_size++;
+  Insert (packet, hdr, true);
 }
 
 uint32_t
@@ -284,20 +454,23 @@ WifiMacQueue::GetNPacketsByTidAndAddress (uint8_t tid, WifiMacHeader::AddressTyp
                                           Mac48Address addr)
 {
   Cleanup ();
+  NS_ASSERT (type <= 4);
+  if (type == WifiMacHeader::ADDR1)
+    {
+      Mac48AddressTid key;
+      key.address = addr;
+      key.tid = tid;
+      TidChains::const_iterator it = m_tids.find (key);
+      return it != m_tids.end () ? it->second.n : 0;
+    }
   uint32_t nPackets = 0;
-  if (!m_queue.empty ())
+  for (uint32_t i = m_queue.head; i != NONE; i = m_items[i].next[QUEUE])
     {
-      PacketQueueI it;
-      NS_ASSERT (type <= 4);
-      for (it = m_queue.begin (); it != m_queue.end (); it++)
+      const Item &item = m_items[i];
+      if (GetAddressForPacket (type, item) == addr
+          && item.hdr.IsQosData () && item.hdr.GetQosTid () == tid)
         {
-          if (GetAddressForPacket (type, it) == addr)
-            {
-              if (it->hdr.IsQosData () && it->hdr.GetQosTid () == tid)
-                {
-                  nPackets++;
-                }
-            }
+          nPackets++;
         }
     }
   return nPackets;
@@ -308,21 +481,19 @@ WifiMacQueue::DequeueFirstAvailable (WifiMacHeader *hdr, Time &timestamp,
                                      const QosBlockedDestinations *blockedPackets)
 {
   Cleanup ();
-  Ptr<const Packet> packet = 0;
-  for (PacketQueueI it = m_queue.begin (); it != m_queue.end (); it++)
+  for (uint32_t i = m_queue.head; i != NONE; i = m_items[i].next[QUEUE])
     {
-      if (!it->hdr.IsQosData ()
-          || !blockedPackets->IsBlocked (it->hdr.GetAddr1 (), it->hdr.GetQosTid ()))
+      const Item &item = m_items[i];
+      if (!item.hdr.IsQosData ()
+          || !blockedPackets->IsBlocked (item.hdr.GetAddr1 (), item.hdr.GetQosTid ()))
         {
-          *hdr = it->hdr;
-          timestamp = it->tstamp;
-          packet = it->packet;
-          m_queue.erase (it);
-          m_size--;
+          timestamp = item.tstamp;
+          Ptr<const Packet> packet = Get (i, hdr);
+          Erase (i, true);
           return packet;
         }
     }
-  return packet;
+  return 0;
 }
 
 Ptr<const Packet>
@@ -330,14 +501,14 @@ WifiMacQueue::PeekFirstAvailable (WifiMacHeader *hdr, Time &timestamp,
                                   const QosBlockedDestinations *blockedPackets)
 {
   Cleanup ();
-  for (PacketQueueI it = m_queue.begin (); it != m_queue.end (); it++)
+  for (uint32_t i = m_queue.head; i != NONE; i = m_items[i].next[QUEUE])
     {
-      if (!it->hdr.IsQosData ()
-          || !blockedPackets->IsBlocked (it->hdr.GetAddr1 (), it->hdr.GetQosTid ()))
+      const Item &item = m_items[i];
+      if (!item.hdr.IsQosData ()
+          || !blockedPackets->IsBlocked (item.hdr.GetAddr1 (), item.hdr.GetQosTid ()))
         {
-          *hdr = it->hdr;
-          timestamp = it->tstamp;
-          return it->packet;
+          timestamp = item.tstamp;
+          return Get (i, hdr);
         }
     }
   return 0;
@@ -22,11 +22,15 @@
 #ifndef WIFI_MAC_QUEUE_H
 #define WIFI_MAC_QUEUE_H
 
-#include <list>
 #include <utility>
+#include <vector>
 #include "ns3/packet.h"
 #include "ns3/nstime.h"
 #include "ns3/object.h"
+#include "ns3/traced-value.h"
+#include "ns3/traced-callback.h"
+#include "ns3/sgi-hashmap.h"
+#include "ns3/mac48-address.h"
 #include "wifi-mac-header.h"
 
 namespace ns3 {
@@ -48,6 +52,14 @@ class QosBlockedDestinations;
  * to verify whether or not it should be dropped. If
  * dot11EDCATableMSDULifetime has elapsed, it is dropped.
  * Otherwise, it is returned to the caller.
+ *
+ * The packets are kept in a pool of slots which are reused once their
+ * packet leaves the queue, and are chained in the order of the queue,
+ * in the order of their arrival, which is the order in which they
+ * expire, and, for address 1, per receiver and per receiver and TID.
+ * Hence expired packets are dropped without walking the queue and the
+ * lookups by address 1 only visit the packets of that receiver. The
+ * lookups by another address type walk the whole queue.
  */
 class WifiMacQueue : public Object
 {
@@ -87,6 +99,31 @@ public:
                                          uint8_t tid,
                                          WifiMacHeader::AddressType type,
                                          Mac48Address addr);
+  /**
+   * Searchs and returns, if is present in this queue, first packet having
+   * address indicated by <i>type</i> equals to <i>addr</i>. This method
+   * removes the packet from this queue.
+   * Is typically used by ns3::DataDcaTxop in order to send the packets of
+   * a burst reserved for a single receiver.
+   */
+  Ptr<const Packet> DequeueByAddress (WifiMacHeader *hdr,
+                                      WifiMacHeader::AddressType type,
+                                      Mac48Address addr);
+  /**
+   * Fills <i>packets</i> and <i>hdrs</i> with, at most, the <i>maxN</i> first
+   * packets having address indicated by <i>type</i> equals to <i>addr</i>,
+   * in the order of this queue. This method doesn't remove the packets from
+   * this queue.
+   * Is typically used by ns3::DataDcaTxop in order to reserve a burst of
+   * packets for a single receiver.
+   *
+   * \returns the number of packets found.
+   */
+  uint32_t PeekByAddress (std::vector<Ptr<const Packet> > &packets,
+                          std::vector<WifiMacHeader> &hdrs,
+                          WifiMacHeader::AddressType type,
+                          Mac48Address addr,
+                          uint32_t maxN);
   /**
    * If exists, removes <i>packet</i> from queue and returns true. Otherwise it
    * takes no effects and return false. Deletion of the packet is
@@ -121,30 +158,65 @@ public:
   bool IsEmpty (void);
   uint32_t GetSize (void);
 private:
-  struct Item;
-
-  typedef std::list<struct Item> PacketQueue;
-  typedef std::list<struct Item>::reverse_iterator PacketQueueRI;
-  typedef std::list<struct Item>::iterator PacketQueueI;
-
-  void Cleanup (void);
-  Mac48Address GetAddressForPacket (enum WifiMacHeader::AddressType type, PacketQueueI);
+  /* the chains an item belongs to */
+  enum Link
+  {
+    QUEUE = 0,  // order of the queue, also used to chain the free slots
+    ARRIVAL,    // order of arrival
+    RECEIVER,   // order of the queue, per address 1
+    RECEIVER_TID, // order of the queue, per address 1 and TID of QoS data
+    N_LINKS
+  };
+  struct Chain
+  {
+    Chain ();
+    uint32_t head;
+    uint32_t tail;
+    uint32_t n;
+  };
+  typedef sgi::hash_map<Mac48Address, Chain, Mac48AddressHash> ReceiverChains;
+  typedef sgi::hash_map<Mac48AddressTid, Chain, Mac48AddressTidHash> TidChains;
 
   struct Item
   {
-    Item (Ptr<const Packet> packet,
-          const WifiMacHeader &hdr,
-          Time tstamp);
     Ptr<const Packet> packet;
     WifiMacHeader hdr;
     Time tstamp;
+    uint32_t prev[N_LINKS];
+    uint32_t next[N_LINKS];
   };
 
-  PacketQueue m_queue;
+  void Cleanup (void);
+  Mac48Address GetAddressForPacket (enum WifiMacHeader::AddressType type, const Item &item) const;
+  void Insert (Ptr<const Packet> packet, const WifiMacHeader &hdr, bool front);
+  /**
+   * Remove the item of the slot <i>i</i> and free its slot.
+   * If <i>sent</i>, the packet left the queue to be transmitted.
+   */
+  void Erase (uint32_t i, bool sent);
+  void Attach (Chain &chain, enum Link link, uint32_t i, bool front);
+  void Detach (Chain &chain, enum Link link, uint32_t i);
+  /**
+   * \returns the slot of the first packet having address indicated by
+   *          <i>type</i> equals to <i>addr</i> and, if <i>qosTid</i>, the
+   *          QoS data packet with TID <i>tid</i>, NONE if there is none.
+   */
+  uint32_t Find (WifiMacHeader::AddressType type, Mac48Address addr, bool qosTid, uint8_t tid) const;
+  Ptr<const Packet> Get (uint32_t i, WifiMacHeader *hdr) const;
+
+  static const uint32_t NONE = 0xffffffff;
+
+  std::vector<Item> m_items;
+  uint32_t m_free;
+  Chain m_queue;
+  Chain m_arrival;
+  ReceiverChains m_receivers;
+  TidChains m_tids;
   WifiMacParameters *m_parameters;
-  uint32_t m_size;
+  TracedValue<uint32_t> m_size;
   uint32_t m_maxSize;
   Time m_maxDelay;
+  TracedCallback<Ptr<const Packet>, Time> m_sojournTrace;
 };
 
 } // namespace ns3
@@ -183,7 +183,7 @@ WifiPhyStateHelper::GetState (void)
 
 
 void
-WifiPhyStateHelper::NotifyTxStart (Time duration, WifiMacHeader hdr)
+WifiPhyStateHelper::NotifyTxStart (Time duration, const WifiMacHeader &hdr)
 {
   for (Listeners::const_iterator i = m_listeners.begin (); i != m_listeners.end (); i++)
     {
@@ -191,7 +191,7 @@ WifiPhyStateHelper::NotifyTxStart (Time duration, WifiMacHeader hdr)
     }
 }
 void
-WifiPhyStateHelper::NotifyRxStart (Time rxDuration, WifiMacHeader hdr, Ptr<const Packet> packet)
+WifiPhyStateHelper::NotifyRxStart (Time rxDuration, const WifiMacHeader &hdr, Ptr<const Packet> packet)
 {
   for (Listeners::const_iterator i = m_listeners.begin (); i != m_listeners.end (); i++)
     {
@@ -297,7 +297,7 @@ WifiPhyStateHelper::SwitchToTx (Time txDuration, Ptr<const Packet> packet, WifiM
   m_startTx = now;
 }
 void
-WifiPhyStateHelper::SwitchToRx (Time rxDuration, WifiMacHeader hdr, Ptr<const Packet> packet)
+WifiPhyStateHelper::SwitchToRx (Time rxDuration, const WifiMacHeader &hdr, Ptr<const Packet> packet)
 {
   NS_ASSERT (IsStateIdle () || IsStateCcaBusy ());
   NS_ASSERT (!m_rxing);
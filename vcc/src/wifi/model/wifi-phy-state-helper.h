@@ -55,7 +55,7 @@ public:
   Time GetLastRxStartTime (void) const;
 
   void SwitchToTx (Time txDuration, Ptr<const Packet> packet, WifiMode txMode, WifiPreamble preamble, uint8_t txPower);
-  void SwitchToRx (Time rxDuration, WifiMacHeader hdr, Ptr<const Packet> packet);
+  void SwitchToRx (Time rxDuration, const WifiMacHeader &hdr, Ptr<const Packet> packet);
   void SwitchToChannelSwitching (Time switchingDuration);
   void SwitchFromRxEndOk (Ptr<Packet> packet, double snr, WifiMode mode, enum WifiPreamble preamble);
   void SwitchFromRxEndError (Ptr<const Packet> packet, double snr);
@@ -67,9 +67,9 @@ private:
 
   void LogPreviousIdleAndCcaBusyStates (void);
 
-  void NotifyTxStart (Time duration, WifiMacHeader hdr);
+  void NotifyTxStart (Time duration, const WifiMacHeader &hdr);
   void NotifyWakeup (void);
-  void NotifyRxStart (Time rxDuration, WifiMacHeader hdr, Ptr<const Packet> packet);
+  void NotifyRxStart (Time rxDuration, const WifiMacHeader &hdr, Ptr<const Packet> packet);
   void NotifyRxEndOk (void);
   void NotifyRxEndError (void);
   void NotifyMaybeCcaBusyStart (Time duration);
@@ -299,6 +299,39 @@ WifiPhy::CalculateTxDuration (uint32_t size, WifiMode payloadMode, WifiPreamble
   return MicroSeconds (duration);
 }
 
+Time
+WifiPhy::GetTxDuration (uint32_t size, WifiMode payloadMode, WifiPreamble preamble)
+{
+  uint32_t row = payloadMode.GetUid () * 2 + (preamble == WIFI_PREAMBLE_SHORT ? 1 : 0);
+  if (size < TX_DURATION_TABLE_SIZE)
+    {
+      uint32_t index = row * TX_DURATION_TABLE_SIZE + size;
+      if (index >= m_controlTxDurations.size ())
+        {
+          m_controlTxDurations.resize ((row + 1) * TX_DURATION_TABLE_SIZE, Seconds (0));
+        }
+      // a frame never lasts 0, whatever its size
+      if (m_controlTxDurations[index].IsZero ())
+        {
+          m_controlTxDurations[index] = CalculateTxDuration (size, payloadMode, preamble);
+        }
+      return m_controlTxDurations[index];
+    }
+  if (size > 0xffff || row > 0x7fff)
+    {
+      return CalculateTxDuration (size, payloadMode, preamble);
+    }
+  uint32_t key = (row << 16) | size;
+  TxDurations::const_iterator it = m_txDurations.find (key);
+  if (it != m_txDurations.end ())
+    {
+      return it->second;
+    }
+  Time duration = CalculateTxDuration (size, payloadMode, preamble);
+  m_txDurations[key] = duration;
+  return duration;
+}
+
 
 void
 WifiPhy::NotifyTxBegin (Ptr<const Packet> packet)
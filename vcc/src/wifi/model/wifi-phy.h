@@ -32,6 +32,8 @@
 #include "wifi-phy-standard.h"
 #include "wifi-mac-header.h"
 #include "ns3/traced-callback.h"
+#include "ns3/sgi-hashmap.h"
+#include <vector>
 
 
 namespace ns3 {
@@ -59,7 +61,7 @@ public:
    *   - NotifyRxEndError
    *   - NotifyTxStart
    */
-  virtual void NotifyRxStart (Time rxDuration, WifiMacHeader hdr, Ptr<const Packet> packet) = 0;
+  virtual void NotifyRxStart (Time rxDuration, const WifiMacHeader &hdr, Ptr<const Packet> packet) = 0;
   /**
    * We have received the last bit of a packet for which
    * NotifyRxStart was invoked first and, the packet has
@@ -81,7 +83,7 @@ public:
    * channel implicitely reverts to the idle state
    * unless they have received a cca busy report.
    */
-  virtual void NotifyTxStart (Time duration, WifiMacHeader hdr) = 0;
+  virtual void NotifyTxStart (Time duration, const WifiMacHeader &hdr) = 0;
 
   /**
    * \param duration the expected busy duration.
@@ -244,6 +246,17 @@ public:
    *          the transmission of these bytes.
    */
   static Time CalculateTxDuration (uint32_t size, WifiMode payloadMode, enum WifiPreamble preamble);
+  /**
+   * \param size the number of bytes in the packet to send
+   * \param payloadMode the transmission mode to use for this packet
+   * \param preamble the type of preamble to use for this packet.
+   * \return the same duration as CalculateTxDuration
+   *
+   * The durations are memoized in this PHY: the control frames, smaller
+   * than TX_DURATION_TABLE_SIZE bytes, are looked up in a table indexed by
+   * their size, the other frames in a hash table.
+   */
+  Time GetTxDuration (uint32_t size, WifiMode payloadMode, enum WifiPreamble preamble);
 
   /** 
    * \param payloadMode the WifiMode use for the transmission of the payload
@@ -462,6 +475,13 @@ public:
 
 
 private:
+  /* one row of the control frame durations per mode and preamble */
+  static const uint32_t TX_DURATION_TABLE_SIZE = 64;
+  typedef sgi::hash_map<uint32_t, Time> TxDurations;
+
+  std::vector<Time> m_controlTxDurations;
+  TxDurations m_txDurations;
+
   /**
    * The trace source fired when a packet begins the transmission process on
    * the medium.
@@ -189,6 +189,7 @@ WifiRemoteStationManager::GetTypeId (void)
 }
 
 WifiRemoteStationManager::WifiRemoteStationManager ()
+  : m_lastStation (0)
 {
 }
 
@@ -208,6 +209,9 @@ WifiRemoteStationManager::DoDispose (void)
       delete (*i);
     }
   m_stations.clear ();
+  m_stateIndex.clear ();
+  m_stationIndex.clear ();
+  m_lastStation = 0;
 }
 void
 WifiRemoteStationManager::SetupPhy (Ptr<WifiPhy> phy)
@@ -716,18 +720,17 @@ WifiRemoteStationManager::GetInfo (Mac48Address address)
 WifiRemoteStationState *
 WifiRemoteStationManager::LookupState (Mac48Address address) const
 {
-  for (StationStates::const_iterator i = m_states.begin (); i != m_states.end (); i++)
+  StateIndex::const_iterator it = m_stateIndex.find (address);
+  if (it != m_stateIndex.end ())
     {
-      if ((*i)->m_address == address)
-        {
-          return (*i);
-        }
+      return it->second;
     }
   WifiRemoteStationState *state = new WifiRemoteStationState ();
   state->m_state = WifiRemoteStationState::BRAND_NEW;
   state->m_address = address;
   state->m_operationalRateSet.push_back (GetDefaultMode ());
   const_cast<WifiRemoteStationManager *> (this)->m_states.push_back (state);
+  const_cast<WifiRemoteStationManager *> (this)->m_stateIndex[address] = state;
   return state;
 }
 WifiRemoteStation *
@@ -747,13 +750,21 @@ WifiRemoteStationManager::Lookup (Mac48Address address, const WifiMacHeader *hea
 WifiRemoteStation *
 WifiRemoteStationManager::Lookup (Mac48Address address, uint8_t tid) const
 {
-  for (Stations::const_iterator i = m_stations.begin (); i != m_stations.end (); i++)
+  WifiRemoteStationManager *self = const_cast<WifiRemoteStationManager *> (this);
+  if (m_lastStation != 0
+      && m_lastStation->m_tid == tid
+      && m_lastStation->m_state->m_address == address)
     {
-      if ((*i)->m_tid == tid
-          && (*i)->m_state->m_address == address)
-        {
-          return (*i);
-        }
+      return m_lastStation;
+    }
+  Mac48AddressTid key;
+  key.address = address;
+  key.tid = tid;
+  StationIndex::const_iterator it = m_stationIndex.find (key);
+  if (it != m_stationIndex.end ())
+    {
+      self->m_lastStation = it->second;
+      return it->second;
     }
   WifiRemoteStationState *state = LookupState (address);
 
@@ -763,7 +774,9 @@ WifiRemoteStationManager::Lookup (Mac48Address address, uint8_t tid) const
   station->m_ssrc = 0;
   station->m_slrc = 0;
   // XXX
-  const_cast<WifiRemoteStationManager *> (this)->m_stations.push_back (station);
+  self->m_stations.push_back (station);
+  self->m_stationIndex[key] = station;
+  self->m_lastStation = station;
   return station;
 
 }
@@ -781,6 +794,8 @@ WifiRemoteStationManager::Reset (void)
       delete (*i);
     }
   m_stations.clear ();
+  m_stationIndex.clear ();
+  m_lastStation = 0;
   m_bssBasicRateSet.clear ();
   m_bssBasicRateSet.push_back (m_defaultTxMode);
   NS_ASSERT (m_defaultTxMode.IsMandatory ());
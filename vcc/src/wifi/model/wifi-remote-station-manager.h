@@ -23,6 +23,7 @@
 #include <vector>
 #include <utility>
 #include "ns3/mac48-address.h"
+#include "ns3/sgi-hashmap.h"
 #include "ns3/traced-callback.h"
 #include "ns3/packet.h"
 #include "ns3/object.h"
@@ -400,9 +401,17 @@ private:
 
   typedef std::vector <WifiRemoteStation *> Stations;
   typedef std::vector <WifiRemoteStationState *> StationStates;
+  typedef sgi::hash_map<Mac48Address, WifiRemoteStationState *, Mac48AddressHash> StateIndex;
+  typedef sgi::hash_map<Mac48AddressTid, WifiRemoteStation *, Mac48AddressTidHash> StationIndex;
 
   StationStates m_states;
   Stations m_stations;
+  /* the same states and stations, hashed for Lookup and LookupState */
+  StateIndex m_stateIndex;
+  StationIndex m_stationIndex;
+  /* the station found by the last Lookup: the MACs query the same
+   * station several times per frame */
+  WifiRemoteStation *m_lastStation;
   /**
    * This is a pointer to the WifiPhy associated with this
    * WifiRemoteStationManager that is set on call to
@@ -487,6 +496,8 @@ struct WifiRemoteStationState
  */
 struct WifiRemoteStation
 {
+  /* the stations of the subclasses are deleted by this base class */
+  virtual ~WifiRemoteStation () {}
   WifiRemoteStationState *m_state;
   uint32_t m_ssrc;
   uint32_t m_slrc;
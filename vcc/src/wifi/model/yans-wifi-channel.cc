@@ -17,6 +17,8 @@
  *
  * Author: Mathieu Lacage, <mathieu.lacage@sophia.inria.fr>
  */
+#include <algorithm>
+#include <cmath>
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 #include "ns3/mobility-model.h"
@@ -24,6 +26,7 @@
 #include "ns3/node.h"
 #include "ns3/log.h"
 #include "ns3/pointer.h"
+#include "ns3/double.h"
 #include "ns3/object-factory.h"
 #include "yans-wifi-channel.h"
 #include "yans-wifi-phy.h"
@@ -50,17 +53,44 @@ YansWifiChannel::GetTypeId (void)
                    PointerValue (),
                    MakePointerAccessor (&YansWifiChannel::m_delay),
                    MakePointerChecker<PropagationDelayModel> ())
+    .AddAttribute ("MaxLossDb",
+                   "The maximum propagation loss in dB for which transmissions are "
+                   "passed to the receiving PHY. Signals for which the PropagationLossModel "
+                   "returns a bigger loss are not propagated to the receiver. The default "
+                   "value corresponds to considering all signals for reception.",
+                   DoubleValue (1.0e9),
+                   MakeDoubleAccessor (&YansWifiChannel::m_maxLossDb),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("MaxRange",
+                   "The maximum distance in meters between the sender and a receiver for "
+                   "the transmission to be passed to the receiving PHY. Farther receivers "
+                   "are looked up in a spatial grid and skipped without querying the "
+                   "propagation models. Zero disables the cutoff. Tune this value with care "
+                   "when a random propagation loss model is used, since it changes the "
+                   "number of random variates drawn.",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&YansWifiChannel::m_maxRange),
+                   MakeDoubleChecker<double> (0.0))
   ;
   return tid;
 }
 
 YansWifiChannel::YansWifiChannel ()
+  : m_gridCellSize (0.0),
+    m_nGridPhys (0)
 {
 }
 YansWifiChannel::~YansWifiChannel ()
 {
   NS_LOG_FUNCTION_NOARGS ();
   m_phyList.clear ();
+  m_phyChannelNumbers.clear ();
+  m_channelPhys.clear ();
+  m_grid.clear ();
+  m_movingPhys.clear ();
+  m_phyCells.clear ();
+  m_phyMoving.clear ();
+  m_mobilityPhys.clear ();
 }
 
 void
@@ -76,46 +106,100 @@ YansWifiChannel::SetPropagationDelayModel (Ptr<PropagationDelayModel> delay)
 
 void
 YansWifiChannel::Send (Ptr<YansWifiPhy> sender, Ptr<const Packet> packet, double txPowerDbm,
-                       WifiMode wifiMode, WifiPreamble preamble) const
+                       WifiMode wifiMode, WifiPreamble preamble)
 {
   Ptr<MobilityModel> senderMobility = sender->GetMobility ()->GetObject<MobilityModel> ();
   NS_ASSERT (senderMobility != 0);
-  uint32_t j = 0;
-  for (PhyList::const_iterator i = m_phyList.begin (); i != m_phyList.end (); i++, j++)
+  // For now don't account for inter channel interference: only the
+  // PHYs on the channel of the sender are visited.
+  uint16_t channelNumber = sender->GetChannelNumber ();
+  ChannelPhyMap::const_iterator channel = m_channelPhys.find (channelNumber);
+  if (channel == m_channelPhys.end ())
     {
-      if (sender != (*i))
+      return;
+    }
+  // all the receivers share the same immutable copy of the packet: it is
+  // copied again by a receiver only if it synchronizes on the signal.
+  Ptr<const Packet> copy = packet->Copy ();
+
+  if (m_maxRange <= 0.0)
+    {
+      const PhyIndexList &phys = channel->second;
+      for (PhyIndexList::const_iterator i = phys.begin (); i != phys.end (); i++)
         {
-          // For now don't account for inter channel interference
-          if ((*i)->GetChannelNumber () != sender->GetChannelNumber ())
+          if (sender != m_phyList[*i])
             {
-              continue;
+              SendTo (*i, senderMobility, copy, txPowerDbm, wifiMode, preamble);
             }
+        }
+      return;
+    }
 
-          Ptr<MobilityModel> receiverMobility = (*i)->GetMobility ()->GetObject<MobilityModel> ();
-          Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
-          double rxPowerDbm = m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobility);
-          NS_LOG_DEBUG ("propagation: txPower=" << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, " <<
-                        "distance=" << senderMobility->GetDistanceFrom (receiverMobility) << "m, delay=" << delay);
-          Ptr<Packet> copy = packet->Copy ();
-          Ptr<Object> dstNetDevice = m_phyList[j]->GetDevice ();
-          uint32_t dstNode;
-          if (dstNetDevice == 0)
-            {
-              dstNode = 0xffffffff;
-            }
-          else
+  UpdateGrid ();
+  // the receivers within range are either moving or stored in one of
+  // the 3x3 cells centered on the cell of the sender.
+  PhyIndexList candidates = m_movingPhys;
+  GridCell center = GetCell (senderMobility->GetPosition ());
+  for (int64_t x = center.first - 1; x <= center.first + 1; x++)
+    {
+      for (int64_t y = center.second - 1; y <= center.second + 1; y++)
+        {
+          Grid::const_iterator cell = m_grid.find (GridCell (x, y));
+          if (cell != m_grid.end ())
             {
-              dstNode = dstNetDevice->GetObject<NetDevice> ()->GetNode ()->GetId ();
+              candidates.insert (candidates.end (), cell->second.begin (), cell->second.end ());
             }
-          Simulator::ScheduleWithContext (dstNode,
-                                          delay, &YansWifiChannel::Receive, this,
-                                          j, copy, rxPowerDbm, wifiMode, preamble);
         }
     }
+  // visit the receivers in the same order as without the cutoff
+  std::sort (candidates.begin (), candidates.end ());
+  for (PhyIndexList::const_iterator i = candidates.begin (); i != candidates.end (); i++)
+    {
+      uint32_t j = *i;
+      if (m_phyChannelNumbers[j] != channelNumber || sender == m_phyList[j])
+        {
+          continue;
+        }
+      Ptr<MobilityModel> receiverMobility = m_phyList[j]->GetMobility ()->GetObject<MobilityModel> ();
+      if (senderMobility->GetDistanceFrom (receiverMobility) > m_maxRange)
+        {
+          continue;
+        }
+      SendTo (j, senderMobility, copy, txPowerDbm, wifiMode, preamble);
+    }
+}
+
+void
+YansWifiChannel::SendTo (uint32_t i, Ptr<MobilityModel> senderMobility, Ptr<const Packet> packet,
+                         double txPowerDbm, WifiMode wifiMode, WifiPreamble preamble) const
+{
+  Ptr<MobilityModel> receiverMobility = m_phyList[i]->GetMobility ()->GetObject<MobilityModel> ();
+  Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
+  double rxPowerDbm = m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobility);
+  NS_LOG_DEBUG ("propagation: txPower=" << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, " <<
+                "distance=" << senderMobility->GetDistanceFrom (receiverMobility) << "m, delay=" << delay);
+  if (txPowerDbm - rxPowerDbm > m_maxLossDb)
+    {
+      NS_LOG_LOGIC ("loss above MaxLossDb, signal not propagated to phy " << i);
+      return;
+    }
+  Ptr<Object> dstNetDevice = m_phyList[i]->GetDevice ();
+  uint32_t dstNode;
+  if (dstNetDevice == 0)
+    {
+      dstNode = 0xffffffff;
+    }
+  else
+    {
+      dstNode = dstNetDevice->GetObject<NetDevice> ()->GetNode ()->GetId ();
+    }
+  Simulator::ScheduleWithContext (dstNode,
+                                  delay, &YansWifiChannel::Receive, this,
+                                  i, packet, rxPowerDbm, wifiMode, preamble);
 }
 
 void
-YansWifiChannel::Receive (uint32_t i, Ptr<Packet> packet, double rxPowerDbm,
+YansWifiChannel::Receive (uint32_t i, Ptr<const Packet> packet, double rxPowerDbm,
                           WifiMode txMode, WifiPreamble preamble) const
 {
   m_phyList[i]->StartReceivePacket (packet, rxPowerDbm, txMode, preamble);
@@ -135,7 +219,164 @@ YansWifiChannel::GetDevice (uint32_t i) const
 void
 YansWifiChannel::Add (Ptr<YansWifiPhy> phy)
 {
+  uint32_t i = m_phyList.size ();
   m_phyList.push_back (phy);
+  m_phyChannelNumbers.push_back (phy->GetChannelNumber ());
+  AddToChannel (i, phy->GetChannelNumber ());
+}
+
+void
+YansWifiChannel::NotifyChannelNumberChange (Ptr<YansWifiPhy> phy)
+{
+  // channel switches are rare, a linear search is good enough here
+  for (uint32_t i = 0; i < m_phyList.size (); i++)
+    {
+      if (m_phyList[i] == phy)
+        {
+          uint16_t nch = phy->GetChannelNumber ();
+          if (m_phyChannelNumbers[i] != nch)
+            {
+              NS_LOG_DEBUG ("phy " << i << " moves from channel " << m_phyChannelNumbers[i] << " to " << nch);
+              RemoveFromChannel (i, m_phyChannelNumbers[i]);
+              AddToChannel (i, nch);
+              m_phyChannelNumbers[i] = nch;
+            }
+          return;
+        }
+    }
+}
+
+void
+YansWifiChannel::AddToChannel (uint32_t i, uint16_t channelNumber)
+{
+  InsertIndex (m_channelPhys[channelNumber], i);
+}
+
+void
+YansWifiChannel::RemoveFromChannel (uint32_t i, uint16_t channelNumber)
+{
+  RemoveIndex (m_channelPhys[channelNumber], i);
+}
+
+void
+YansWifiChannel::InsertIndex (PhyIndexList &phys, uint32_t i)
+{
+  // keep the indices sorted so that receivers are visited in the order
+  // they were added to the channel, whatever the channel switches.
+  phys.insert (std::lower_bound (phys.begin (), phys.end (), i), i);
+}
+
+void
+YansWifiChannel::RemoveIndex (PhyIndexList &phys, uint32_t i)
+{
+  PhyIndexList::iterator it = std::lower_bound (phys.begin (), phys.end (), i);
+  NS_ASSERT (it != phys.end () && *it == i);
+  phys.erase (it);
+}
+
+YansWifiChannel::GridCell
+YansWifiChannel::GetCell (const Vector &position) const
+{
+  return GridCell (static_cast<int64_t> (std::floor (position.x / m_gridCellSize)),
+                   static_cast<int64_t> (std::floor (position.y / m_gridCellSize)));
+}
+
+void
+YansWifiChannel::UpdateGrid (void)
+{
+  if (m_gridCellSize != m_maxRange)
+    {
+      NS_LOG_DEBUG ("build grid with cells of " << m_maxRange << "m");
+      m_grid.clear ();
+      m_movingPhys.clear ();
+      m_gridCellSize = m_maxRange;
+      m_nGridPhys = 0;
+    }
+  m_phyCells.resize (m_phyList.size ());
+  m_phyMoving.resize (m_phyList.size (), false);
+  // the mobility models may be aggregated after the PHYs are added to the
+  // channel, so the PHYs are indexed lazily, on the first transmission.
+  for (; m_nGridPhys < m_phyList.size (); m_nGridPhys++)
+    {
+      uint32_t i = m_nGridPhys;
+      Ptr<MobilityModel> mobility = m_phyList[i]->GetMobility ()->GetObject<MobilityModel> ();
+      NS_ASSERT (mobility != 0);
+      MobilityPhyMap::iterator it = m_mobilityPhys.find (PeekPointer (mobility));
+      if (it == m_mobilityPhys.end ())
+        {
+          mobility->TraceConnectWithoutContext ("CourseChange", MakeCallback (&YansWifiChannel::CourseChanged, this));
+          it = m_mobilityPhys.insert (std::make_pair (PeekPointer (mobility), PhyIndexList ())).first;
+        }
+      if (std::find (it->second.begin (), it->second.end (), i) == it->second.end ())
+        {
+          it->second.push_back (i);
+        }
+      Vector velocity = mobility->GetVelocity ();
+      m_phyMoving[i] = velocity.x != 0 || velocity.y != 0 || velocity.z != 0;
+      if (m_phyMoving[i])
+        {
+          InsertIndex (m_movingPhys, i);
+        }
+      else
+        {
+          m_phyCells[i] = GetCell (mobility->GetPosition ());
+          InsertIndex (m_grid[m_phyCells[i]], i);
+        }
+    }
+}
+
+void
+YansWifiChannel::UpdateGridPosition (uint32_t i)
+{
+  Ptr<MobilityModel> mobility = m_phyList[i]->GetMobility ()->GetObject<MobilityModel> ();
+  Vector velocity = mobility->GetVelocity ();
+  bool moving = velocity.x != 0 || velocity.y != 0 || velocity.z != 0;
+  GridCell cell = moving ? m_phyCells[i] : GetCell (mobility->GetPosition ());
+  if (moving == m_phyMoving[i] && (moving || cell == m_phyCells[i]))
+    {
+      return;
+    }
+  if (m_phyMoving[i])
+    {
+      RemoveIndex (m_movingPhys, i);
+    }
+  else
+    {
+      Grid::iterator old = m_grid.find (m_phyCells[i]);
+      RemoveIndex (old->second, i);
+      if (old->second.empty ())
+        {
+          m_grid.erase (old);
+        }
+    }
+  m_phyMoving[i] = moving;
+  if (moving)
+    {
+      InsertIndex (m_movingPhys, i);
+    }
+  else
+    {
+      m_phyCells[i] = cell;
+      InsertIndex (m_grid[cell], i);
+    }
+}
+
+void
+YansWifiChannel::CourseChanged (Ptr<const MobilityModel> mobility)
+{
+  MobilityPhyMap::const_iterator it = m_mobilityPhys.find (PeekPointer (mobility));
+  if (it == m_mobilityPhys.end () || m_gridCellSize != m_maxRange)
+    {
+      // the grid is rebuilt from scratch on the next transmission
+      return;
+    }
+  for (PhyIndexList::const_iterator i = it->second.begin (); i != it->second.end (); i++)
+    {
+      if (*i < m_nGridPhys)
+        {
+          UpdateGridPosition (*i);
+        }
+    }
 }
 
 int64_t
@@ -21,8 +21,10 @@
 #define YANS_WIFI_CHANNEL_H
 
 #include <vector>
+#include <map>
 #include <stdint.h>
 #include "ns3/packet.h"
+#include "ns3/vector.h"
 #include "wifi-channel.h"
 #include "wifi-mode.h"
 #include "wifi-preamble.h"
@@ -30,6 +32,7 @@
 namespace ns3 {
 
 class NetDevice;
+class MobilityModel;
 class PropagationLossModel;
 class PropagationDelayModel;
 class YansWifiPhy;
@@ -45,6 +48,17 @@ class YansWifiPhy;
  * class and contains a ns3::PropagationLossModel and a ns3::PropagationDelayModel.
  * By default, no propagation models are set so, it is the caller's responsability
  * to set them before using the channel.
+ *
+ * Two optional cutoffs reduce the cost of a transmission in large and
+ * sparse topologies. The MaxLossDb attribute drops the signals whose
+ * propagation loss is above a threshold before a copy of the packet and
+ * a reception event are created for them. The MaxRange attribute skips
+ * every receiver farther than a given distance without even querying the
+ * propagation models: the receivers are then looked up in a grid of
+ * square cells of MaxRange side, which is kept up to date through the
+ * CourseChange trace of their mobility models. Receivers which move at a
+ * non-null velocity are not stored in the grid and are always checked.
+ * Both cutoffs are disabled by default.
  */
 class YansWifiChannel : public WifiChannel
 {
@@ -60,6 +74,14 @@ public:
 
   void Add (Ptr<YansWifiPhy> phy);
 
+  /**
+   * \param phy a PHY attached to this channel
+   *
+   * Must be invoked by the PHY every time its channel number
+   * changes, to keep the per-channel receiver index up to date.
+   */
+  void NotifyChannelNumberChange (Ptr<YansWifiPhy> phy);
+
   /**
    * \param loss the new propagation loss model.
    */
@@ -82,7 +104,7 @@ public:
    * e.g. PHYs that are operating on the same channel.
    */
   void Send (Ptr<YansWifiPhy> sender, Ptr<const Packet> packet, double txPowerDbm,
-             WifiMode wifiMode, WifiPreamble preamble) const;
+             WifiMode wifiMode, WifiPreamble preamble);
 
  /**
   * Assign a fixed random variable stream number to the random variables
@@ -99,13 +121,48 @@ private:
   YansWifiChannel (const YansWifiChannel &);
 
   typedef std::vector<Ptr<YansWifiPhy> > PhyList;
-  void Receive (uint32_t i, Ptr<Packet> packet, double rxPowerDbm,
+  /* indices in m_phyList, kept in increasing order */
+  typedef std::vector<uint32_t> PhyIndexList;
+  typedef std::map<uint16_t, PhyIndexList> ChannelPhyMap;
+  typedef std::pair<int64_t, int64_t> GridCell;
+  typedef std::map<GridCell, PhyIndexList> Grid;
+  typedef std::map<const MobilityModel *, PhyIndexList> MobilityPhyMap;
+  void Receive (uint32_t i, Ptr<const Packet> packet, double rxPowerDbm,
                 WifiMode txMode, WifiPreamble preamble) const;
+  void SendTo (uint32_t i, Ptr<MobilityModel> senderMobility, Ptr<const Packet> packet,
+               double txPowerDbm, WifiMode wifiMode, WifiPreamble preamble) const;
+
+  void AddToChannel (uint32_t i, uint16_t channelNumber);
+  void RemoveFromChannel (uint32_t i, uint16_t channelNumber);
 
+  static void InsertIndex (PhyIndexList &phys, uint32_t i);
+  static void RemoveIndex (PhyIndexList &phys, uint32_t i);
+  GridCell GetCell (const Vector &position) const;
+  /* index the PHYs added since the last call, rebuild if MaxRange changed */
+  void UpdateGrid (void);
+  void UpdateGridPosition (uint32_t i);
+  void CourseChanged (Ptr<const MobilityModel> mobility);
 
   PhyList m_phyList;
+  /* the channel number each entry of m_phyList is indexed under */
+  std::vector<uint16_t> m_phyChannelNumbers;
+  ChannelPhyMap m_channelPhys;
   Ptr<PropagationLossModel> m_loss;
   Ptr<PropagationDelayModel> m_delay;
+  double m_maxLossDb;
+  double m_maxRange;
+
+  /* side of the grid cells, 0 until the grid is built */
+  double m_gridCellSize;
+  /* the PHYs [0, m_nGridPhys) of m_phyList are indexed */
+  uint32_t m_nGridPhys;
+  Grid m_grid;
+  /* PHYs with a non-null velocity, never stored in m_grid */
+  PhyIndexList m_movingPhys;
+  std::vector<GridCell> m_phyCells;
+  std::vector<bool> m_phyMoving;
+  /* the PHYs sharing a mobility model, whose CourseChange is connected */
+  MobilityPhyMap m_mobilityPhys;
 };
 
 } // namespace ns3
@@ -335,6 +335,10 @@ YansWifiPhy::SetChannelNumber (uint16_t nch)
       // this is not channel switch, this is initialization
       NS_LOG_DEBUG ("start at channel " << nch);
       m_channelNumber = nch;
+      if (m_channel != 0)
+        {
+          m_channel->NotifyChannelNumberChange (this);
+        }
       return;
     }
 
@@ -374,6 +378,10 @@ switchChannel:
    * out the state of the medium after the switching.
    */
   m_channelNumber = nch;
+  if (m_channel != 0)
+    {
+      m_channel->NotifyChannelNumberChange (this);
+    }
 }
 
 uint16_t
@@ -399,7 +407,7 @@ YansWifiPhy::SetReceiveErrorCallback (RxErrorCallback callback)
   m_state->SetReceiveErrorCallback (callback);
 }
 void
-YansWifiPhy::StartReceivePacket (Ptr<Packet> packet,
+YansWifiPhy::StartReceivePacket (Ptr<const Packet> packet,
                                  double rxPowerDbm,
                                  WifiMode txMode,
                                  enum WifiPreamble preamble)
@@ -407,7 +415,7 @@ YansWifiPhy::StartReceivePacket (Ptr<Packet> packet,
   NS_LOG_FUNCTION (this << packet << rxPowerDbm << txMode << preamble);
   rxPowerDbm += m_rxGainDb;
   double rxPowerW = DbmToW (rxPowerDbm);
-  Time rxDuration = CalculateTxDuration (packet->GetSize (), txMode, preamble);
+  Time rxDuration = GetTxDuration (packet->GetSize (), txMode, preamble);
   Time endRx = Simulator::Now () + rxDuration;
 
   Ptr<InterferenceHelper::Event> event;
@@ -479,8 +487,10 @@ YansWifiPhy::StartReceivePacket (Ptr<Packet> packet,
           NS_ASSERT (m_endRxEvent.IsExpired ());
           NotifyRxBegin (packet);
           m_interference.NotifyRxStart ();
+          // the packet is shared with the other receivers of the same
+          // transmission, the upper layers get their own copy.
           m_endRxEvent = Simulator::Schedule (rxDuration, &YansWifiPhy::EndReceive, this,
-                                              packet,
+                                              packet->Copy (),
                                               event);
         }
       else
@@ -520,7 +530,7 @@ YansWifiPhy::SendPacket (Ptr<const Packet> packet, WifiMode txMode, WifiPreamble
    */
   NS_ASSERT (!m_state->IsStateTx () && !m_state->IsStateSwitching ());
 
-  Time txDuration = CalculateTxDuration (packet->GetSize (), txMode, preamble);
+  Time txDuration = GetTxDuration (packet->GetSize (), txMode, preamble);
   if (m_state->IsStateRx ())
     {
       m_endRxEvent.Cancel ();
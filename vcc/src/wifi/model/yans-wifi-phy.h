@@ -89,7 +89,7 @@ public:
   /// Return current center channel frequency in MHz, see SetChannelNumber()
   double GetChannelFrequencyMhz () const;
 
-  void StartReceivePacket (Ptr<Packet> packet,
+  void StartReceivePacket (Ptr<const Packet> packet,
                            double rxPowerDbm,
                            WifiMode mode,
                            WifiPreamble preamble);
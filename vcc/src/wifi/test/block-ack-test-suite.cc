@@ -21,6 +21,8 @@
 #include "ns3/log.h"
 #include "ns3/qos-utils.h"
 #include "ns3/ctrl-headers.h"
+#include "ns3/wifi-mac-header.h"
+#include "ns3/block-ack-cache.h"
 #include <list>
 
 using namespace ns3;
@@ -275,6 +277,59 @@ CtrlBAckResponseHeaderTest::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (m_blockAckHdr.IsPacketReceived (80), false, "error in compressed bitmap");
 }
 
+//Test for the scoreboard of the recipient
+class BlockAckCacheTest : public TestCase
+{
+public:
+  BlockAckCacheTest ();
+private:
+  virtual void DoRun ();
+  void Receive (uint16_t seq);
+  uint64_t GetBitmap (uint16_t startingSeq);
+  BlockAckCache m_cache;
+};
+
+BlockAckCacheTest::BlockAckCacheTest ()
+  : TestCase ("Check the scoreboard of the recipient of a block ack agreement")
+{
+}
+
+void
+BlockAckCacheTest::Receive (uint16_t seq)
+{
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_QOSDATA);
+  hdr.SetSequenceNumber (seq);
+  hdr.SetFragmentNumber (0);
+  m_cache.UpdateWithMpdu (&hdr);
+}
+
+uint64_t
+BlockAckCacheTest::GetBitmap (uint16_t startingSeq)
+{
+  CtrlBAckResponseHeader blockAck;
+  blockAck.SetType (COMPRESSED_BLOCK_ACK);
+  blockAck.SetStartingSequence (startingSeq);
+  m_cache.FillBlockAckBitmap (&blockAck);
+  return blockAck.GetCompressedBitmap ();
+}
+
+void
+BlockAckCacheTest::DoRun (void)
+{
+  m_cache.Init (0, 8);
+  Receive (0);
+  Receive (1);
+  Receive (3);
+  NS_TEST_EXPECT_MSG_EQ (GetBitmap (0), 0x0bLL, "packets in the window");
+
+  // the window moves to 93..100, the entries of 0..7 are not cleared
+  Receive (100);
+  NS_TEST_EXPECT_MSG_EQ (GetBitmap (93), 0x80LL, "only 100 in the new window");
+  NS_TEST_EXPECT_MSG_EQ (GetBitmap (0), 0x0LL, "request before the window");
+  NS_TEST_EXPECT_MSG_EQ (GetBitmap (97), 0x08LL, "request across the end of the window");
+}
+
 class BlockAckTestSuite : public TestSuite
 {
 public:
@@ -287,6 +342,7 @@ BlockAckTestSuite::BlockAckTestSuite ()
   AddTestCase (new PacketBufferingCaseA);
   AddTestCase (new PacketBufferingCaseB);
   AddTestCase (new CtrlBAckResponseHeaderTest);
+  AddTestCase (new BlockAckCacheTest);
 }
 
 static BlockAckTestSuite g_blockAckTestSuite;
@@ -24,6 +24,7 @@
 #include <iostream>
 #include "ns3/interference-helper.h"
 #include "ns3/wifi-phy.h"
+#include "ns3/yans-wifi-phy.h"
 
 NS_LOG_COMPONENT_DEFINE ("InterferenceHelperTxDurationTest");
 
@@ -62,6 +63,8 @@ private:
    */
   bool CheckTxDuration (uint32_t size, WifiMode payloadMode,  WifiPreamble preamble, uint32_t knownDurationMicroSeconds);
 
+  /// the PHY which memoizes the durations, checked along the static computation
+  Ptr<WifiPhy> m_phy;
 };
 
 
@@ -105,6 +108,21 @@ TxDurationTest::CheckTxDuration (uint32_t size, WifiMode payloadMode, WifiPreamb
                 << std::endl;
       return false;
     }
+  // the first call fills the cache of the PHY, the second one reads it
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      uint32_t memoizedDurationMicroSeconds = m_phy->GetTxDuration (size, payloadMode, preamble).GetMicroSeconds ();
+      if (memoizedDurationMicroSeconds != knownDurationMicroSeconds)
+        {
+          std::cerr << " size=" << size
+                    << " mode=" << payloadMode
+                    << " preamble=" << preamble
+                    << " known=" << knownDurationMicroSeconds
+                    << " memoized=" << memoizedDurationMicroSeconds
+                    << std::endl;
+          return false;
+        }
+    }
   return true;
 }
 
@@ -112,6 +130,7 @@ void
 TxDurationTest::DoRun (void)
 {
   bool retval = true;
+  m_phy = CreateObject<YansWifiPhy> ();
 
   // IEEE Std 802.11-2007 Table 18-2 "Example of LENGTH calculations for CCK"
   retval = retval
@@ -177,6 +196,9 @@ TxDurationTest::DoRun (void)
     && CheckTxDuration (1536, WifiPhy::GetErpOfdmRate54Mbps (), WIFI_PREAMBLE_LONG, 254)
     && CheckTxDuration (76, WifiPhy::GetErpOfdmRate54Mbps (), WIFI_PREAMBLE_LONG, 38)
     && CheckTxDuration (14, WifiPhy::GetErpOfdmRate54Mbps (), WIFI_PREAMBLE_LONG, 30);
+
+  m_phy = 0;
+  NS_TEST_EXPECT_MSG_EQ (retval, true, "durations differ from the known values");
 }
 
 class TxDurationTestSuite : public TestSuite
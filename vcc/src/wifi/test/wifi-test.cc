@@ -25,6 +25,7 @@
 #include "ns3/adhoc-wifi-mac.h"
 #include "ns3/yans-wifi-phy.h"
 #include "ns3/arf-wifi-manager.h"
+#include "ns3/minstrel-wifi-manager.h"
 #include "ns3/propagation-delay-model.h"
 #include "ns3/propagation-loss-model.h"
 #include "ns3/error-rate-model.h"
@@ -37,7 +38,28 @@
 #include "ns3/dca-txop.h"
 #include "ns3/mac-rx-middle.h"
 #include "ns3/pointer.h"
+#include "ns3/double.h"
 #include "ns3/rng-seed-manager.h"
+#include "ns3/channel-address-registry.h"
+#include "ns3/ctrl-rts-arbiter.h"
+#include "ns3/nav-schedule.h"
+#include "ns3/mac-low-data.h"
+#include "ns3/data-dca-txop.h"
+#include "ns3/constant-rate-wifi-manager.h"
+#include "ns3/boolean.h"
+#include "ns3/regular-data-wifi-mac.h"
+#include "ns3/wifi-mac-queue.h"
+#include "ns3/vcc-trace-ring.h"
+#include "ns3/interference-helper.h"
+#include "ns3/nist-error-rate-model.h"
+#include "ns3/table-error-rate-model.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/random-variable.h"
+#include <algorithm>
+#include <list>
+#include <sstream>
+#include "ns3/enum.h"
 
 namespace ns3 {
 
@@ -427,6 +449,1138 @@ Bug555TestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (m_secondTransmissionTime, expectedSecondTransmissionTime, "The second transmission time not correct!");
 }
 
+//-----------------------------------------------------------------------------
+/**
+ * Make sure that YansWifiChannel delivers packets only to the PHYs
+ * which are on the channel of the sender, and that its per-channel
+ * index follows the channel switches.
+ */
+class YansWifiChannelPartitionTest : public TestCase
+{
+public:
+  YansWifiChannelPartitionTest ();
+
+  virtual void DoRun (void);
+private:
+  Ptr<YansWifiPhy> CreateOne (Vector pos, uint16_t channelNumber, Ptr<YansWifiChannel> channel);
+  void SendOnePacket (Ptr<YansWifiPhy> phy);
+  void SwitchCh (Ptr<YansWifiPhy> phy, uint16_t channelNumber);
+  void RxBegin (std::string context, Ptr<const Packet> p);
+
+  uint32_t m_rxB;
+  uint32_t m_rxC;
+};
+
+YansWifiChannelPartitionTest::YansWifiChannelPartitionTest ()
+  : TestCase ("YansWifiChannelPartition"),
+    m_rxB (0),
+    m_rxC (0)
+{
+}
+
+Ptr<YansWifiPhy>
+YansWifiChannelPartitionTest::CreateOne (Vector pos, uint16_t channelNumber, Ptr<YansWifiChannel> channel)
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+  mobility->SetPosition (pos);
+  node->AggregateObject (mobility);
+  Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+  phy->SetErrorRateModel (CreateObject<YansErrorRateModel> ());
+  phy->SetChannelNumber (channelNumber);
+  phy->SetChannel (channel);
+  phy->SetMobility (node);
+  phy->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+  return phy;
+}
+
+void
+YansWifiChannelPartitionTest::SendOnePacket (Ptr<YansWifiPhy> phy)
+{
+  phy->SendPacket (Create<Packet> (1000), WifiPhy::GetOfdmRate6Mbps (), WIFI_PREAMBLE_LONG, 0);
+}
+
+void
+YansWifiChannelPartitionTest::SwitchCh (Ptr<YansWifiPhy> phy, uint16_t channelNumber)
+{
+  phy->SetChannelNumber (channelNumber);
+}
+
+void
+YansWifiChannelPartitionTest::RxBegin (std::string context, Ptr<const Packet> p)
+{
+  if (context == "B")
+    {
+      m_rxB++;
+    }
+  else
+    {
+      m_rxC++;
+    }
+}
+
+void
+YansWifiChannelPartitionTest::DoRun (void)
+{
+  Ptr<YansWifiChannel> channel = CreateObject<YansWifiChannel> ();
+  channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+  Ptr<MatrixPropagationLossModel> propLoss = CreateObject<MatrixPropagationLossModel> ();
+  propLoss->SetDefaultLoss (0);
+  channel->SetPropagationLossModel (propLoss);
+
+  Ptr<YansWifiPhy> a = CreateOne (Vector (0.0, 0.0, 0.0), 1, channel);
+  Ptr<YansWifiPhy> b = CreateOne (Vector (5.0, 0.0, 0.0), 1, channel);
+  Ptr<YansWifiPhy> c = CreateOne (Vector (-5.0, 0.0, 0.0), 6, channel);
+  b->TraceConnect ("PhyRxBegin", "B", MakeCallback (&YansWifiChannelPartitionTest::RxBegin, this));
+  c->TraceConnect ("PhyRxBegin", "C", MakeCallback (&YansWifiChannelPartitionTest::RxBegin, this));
+
+  // only b shares the channel of a
+  Simulator::Schedule (Seconds (1.0), &YansWifiChannelPartitionTest::SendOnePacket, this, a);
+  // c joins the channel of a
+  Simulator::Schedule (Seconds (2.0), &YansWifiChannelPartitionTest::SwitchCh, this, c, 1);
+  Simulator::Schedule (Seconds (3.0), &YansWifiChannelPartitionTest::SendOnePacket, this, a);
+  // b leaves the channel of a
+  Simulator::Schedule (Seconds (4.0), &YansWifiChannelPartitionTest::SwitchCh, this, b, 6);
+  Simulator::Schedule (Seconds (5.0), &YansWifiChannelPartitionTest::SendOnePacket, this, a);
+
+  Simulator::Stop (Seconds (10.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_rxB, 2, "b must receive only while on channel 1");
+  NS_TEST_ASSERT_MSG_EQ (m_rxC, 2, "c must receive only after switching to channel 1");
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * Make sure that the MaxRange and MaxLossDb cutoffs of YansWifiChannel
+ * drop the signals they should, and that the spatial grid behind
+ * MaxRange follows the moves of the receivers.
+ */
+class YansWifiChannelCutoffTest : public TestCase
+{
+public:
+  YansWifiChannelCutoffTest ();
+
+  virtual void DoRun (void);
+private:
+  Ptr<YansWifiPhy> CreateOne (Vector pos, Ptr<YansWifiChannel> channel);
+  void SendOnePacket (Ptr<YansWifiPhy> phy);
+  void Move (Ptr<YansWifiPhy> phy, Vector pos);
+  void SetCutoffs (Ptr<YansWifiChannel> channel, double maxRange, double maxLossDb);
+  void RxBegin (std::string context, Ptr<const Packet> p);
+
+  uint32_t m_rxB;
+  uint32_t m_rxC;
+};
+
+YansWifiChannelCutoffTest::YansWifiChannelCutoffTest ()
+  : TestCase ("YansWifiChannelCutoff"),
+    m_rxB (0),
+    m_rxC (0)
+{
+}
+
+Ptr<YansWifiPhy>
+YansWifiChannelCutoffTest::CreateOne (Vector pos, Ptr<YansWifiChannel> channel)
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+  mobility->SetPosition (pos);
+  node->AggregateObject (mobility);
+  Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+  phy->SetErrorRateModel (CreateObject<YansErrorRateModel> ());
+  phy->SetChannel (channel);
+  phy->SetMobility (node);
+  phy->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+  return phy;
+}
+
+void
+YansWifiChannelCutoffTest::SendOnePacket (Ptr<YansWifiPhy> phy)
+{
+  phy->SendPacket (Create<Packet> (1000), WifiPhy::GetOfdmRate6Mbps (), WIFI_PREAMBLE_LONG, 0);
+}
+
+void
+YansWifiChannelCutoffTest::Move (Ptr<YansWifiPhy> phy, Vector pos)
+{
+  phy->GetMobility ()->GetObject<MobilityModel> ()->SetPosition (pos);
+}
+
+void
+YansWifiChannelCutoffTest::SetCutoffs (Ptr<YansWifiChannel> channel, double maxRange, double maxLossDb)
+{
+  channel->SetAttribute ("MaxRange", DoubleValue (maxRange));
+  channel->SetAttribute ("MaxLossDb", DoubleValue (maxLossDb));
+}
+
+void
+YansWifiChannelCutoffTest::RxBegin (std::string context, Ptr<const Packet> p)
+{
+  if (context == "B")
+    {
+      m_rxB++;
+    }
+  else
+    {
+      m_rxC++;
+    }
+}
+
+void
+YansWifiChannelCutoffTest::DoRun (void)
+{
+  Ptr<YansWifiChannel> channel = CreateObject<YansWifiChannel> ();
+  channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+  Ptr<MatrixPropagationLossModel> propLoss = CreateObject<MatrixPropagationLossModel> ();
+  propLoss->SetDefaultLoss (0);
+  channel->SetPropagationLossModel (propLoss);
+  channel->SetAttribute ("MaxRange", DoubleValue (100.0));
+
+  Ptr<YansWifiPhy> a = CreateOne (Vector (0.0, 0.0, 0.0), channel);
+  Ptr<YansWifiPhy> b = CreateOne (Vector (50.0, 0.0, 0.0), channel);
+  Ptr<YansWifiPhy> c = CreateOne (Vector (300.0, 0.0, 0.0), channel);
+  b->TraceConnect ("PhyRxBegin", "B", MakeCallback (&YansWifiChannelCutoffTest::RxBegin, this));
+  c->TraceConnect ("PhyRxBegin", "C", MakeCallback (&YansWifiChannelCutoffTest::RxBegin, this));
+  propLoss->SetLoss (a->GetMobility ()->GetObject<MobilityModel> (),
+                     c->GetMobility ()->GetObject<MobilityModel> (), 50.0);
+
+  // c is out of range
+  Simulator::Schedule (Seconds (1.0), &YansWifiChannelCutoffTest::SendOnePacket, this, a);
+  // c comes within range
+  Simulator::Schedule (Seconds (2.0), &YansWifiChannelCutoffTest::Move, this, c, Vector (0.0, -80.0, 0.0));
+  Simulator::Schedule (Seconds (3.0), &YansWifiChannelCutoffTest::SendOnePacket, this, a);
+  // c goes back out of range
+  Simulator::Schedule (Seconds (4.0), &YansWifiChannelCutoffTest::Move, this, c, Vector (300.0, 0.0, 0.0));
+  Simulator::Schedule (Seconds (5.0), &YansWifiChannelCutoffTest::SendOnePacket, this, a);
+  // no range cutoff, but the loss towards c is too high
+  Simulator::Schedule (Seconds (6.0), &YansWifiChannelCutoffTest::SetCutoffs, this, channel, 0.0, 10.0);
+  Simulator::Schedule (Seconds (7.0), &YansWifiChannelCutoffTest::SendOnePacket, this, a);
+  // no cutoff at all
+  Simulator::Schedule (Seconds (8.0), &YansWifiChannelCutoffTest::SetCutoffs, this, channel, 0.0, 1.0e9);
+  Simulator::Schedule (Seconds (9.0), &YansWifiChannelCutoffTest::SendOnePacket, this, a);
+
+  Simulator::Stop (Seconds (10.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_rxB, 5, "b is always within range");
+  NS_TEST_ASSERT_MSG_EQ (m_rxC, 2, "c must receive only when within range and without MaxLossDb");
+}
+
+//-----------------------------------------------------------------------------
+class ChannelAddressRegistryTest : public TestCase
+{
+public:
+  ChannelAddressRegistryTest () : TestCase ("ChannelAddressRegistry")
+  {
+  }
+  virtual void DoRun (void)
+  {
+    Ptr<ChannelAddressRegistry> registry = CreateObject<ChannelAddressRegistry> ();
+    Ptr<Node> a = CreateObject<Node> ();
+    Ptr<Node> b = CreateObject<Node> ();
+    Mac48Address aData ("00:00:00:00:00:01");
+    Mac48Address aCtrl ("00:00:00:00:00:02");
+    Mac48Address bData ("00:00:00:00:00:03");
+    Mac48Address bCtrl ("00:00:00:00:00:04");
+    registry->Add (a, aData, aCtrl);
+    registry->Add (b, bData, bCtrl);
+    NS_TEST_EXPECT_MSG_EQ (registry->GetN (), 2, "two nodes registered");
+
+    Ptr<Node> node;
+    Mac48Address addr;
+    NS_TEST_EXPECT_MSG_EQ (registry->FindNode (aCtrl, node), true, "ctrl address is known");
+    NS_TEST_EXPECT_MSG_EQ (node, a, "ctrl address maps to its node");
+    NS_TEST_EXPECT_MSG_EQ (registry->GetCtrlAddress (bData, addr), true, "data address is known");
+    NS_TEST_EXPECT_MSG_EQ (addr, bCtrl, "data address maps to the ctrl address of the same node");
+    NS_TEST_EXPECT_MSG_EQ (registry->GetDataAddress (bCtrl, addr), true, "ctrl address is known");
+    NS_TEST_EXPECT_MSG_EQ (addr, bData, "ctrl address maps to the data address of the same node");
+    NS_TEST_EXPECT_MSG_EQ (registry->GetDataAddress (bData, addr), true, "data address is known");
+    NS_TEST_EXPECT_MSG_EQ (addr, bData, "data address maps to itself");
+
+    // re-registering a node with a new ctrl address replaces the old entry
+    Mac48Address aCtrl2 ("00:00:00:00:00:05");
+    registry->Add (a, aData, aCtrl2);
+    NS_TEST_EXPECT_MSG_EQ (registry->GetN (), 2, "re-registration does not add a node");
+    NS_TEST_EXPECT_MSG_EQ (registry->FindNode (aCtrl, node), false, "old ctrl address is forgotten");
+    NS_TEST_EXPECT_MSG_EQ (registry->GetCtrlAddress (aData, addr), true, "data address is still known");
+    NS_TEST_EXPECT_MSG_EQ (addr, aCtrl2, "data address maps to the new ctrl address");
+
+    registry->Remove (bCtrl);
+    NS_TEST_EXPECT_MSG_EQ (registry->GetN (), 1, "one node left");
+    NS_TEST_EXPECT_MSG_EQ (registry->FindNode (bData, node), false, "both addresses of a removed node are forgotten");
+
+    registry->Dispose ();
+    a->Dispose ();
+    b->Dispose ();
+  }
+};
+
+//-----------------------------------------------------------------------------
+class CtrlRtsArbiterTest : public TestCase
+{
+public:
+  CtrlRtsArbiterTest () : TestCase ("CtrlRtsArbiter")
+  {
+  }
+  void CheckExpired (Ptr<CtrlRtsArbiter> arbiter, Mac48Address src)
+  {
+    NS_TEST_EXPECT_MSG_EQ (arbiter->RequestGrant (src, Seconds (3.0)), true, "domain is unlocked at the end of the frame");
+  }
+  virtual void DoRun (void)
+  {
+    Mac48Address a ("00:00:00:00:00:01");
+    Mac48Address b ("00:00:00:00:00:02");
+
+    Ptr<CtrlRtsArbiter> perTx = CreateObject<CtrlRtsArbiter> ();
+    NS_TEST_EXPECT_MSG_EQ (perTx->RequestGrant (a, Seconds (1.0)), true, "first RTS during the frame of a");
+    NS_TEST_EXPECT_MSG_EQ (perTx->RequestGrant (a, Seconds (1.0)), false, "second RTS during the frame of a");
+    NS_TEST_EXPECT_MSG_EQ (perTx->RequestGrant (b, Seconds (1.0)), true, "frames of a and b are distinct domains");
+    NS_TEST_EXPECT_MSG_EQ (perTx->GetNGrants (), 2, "two grants");
+    NS_TEST_EXPECT_MSG_EQ (perTx->GetNDenies (), 1, "one deny");
+
+    Ptr<CtrlRtsArbiter> global = CreateObject<CtrlRtsArbiter> ();
+    global->SetAttribute ("Scope", EnumValue (CtrlRtsArbiter::GLOBAL));
+    NS_TEST_EXPECT_MSG_EQ (global->RequestGrant (a, Seconds (1.0)), true, "first RTS of the simulation");
+    NS_TEST_EXPECT_MSG_EQ (global->RequestGrant (b, Seconds (1.0)), false, "one single domain");
+
+    Simulator::Schedule (Seconds (2.0), &CtrlRtsArbiterTest::CheckExpired, this, perTx, a);
+    Simulator::Schedule (Seconds (2.0), &CtrlRtsArbiterTest::CheckExpired, this, global, b);
+    Simulator::Run ();
+    Simulator::Destroy ();
+
+    perTx->Dispose ();
+    global->Dispose ();
+  }
+};
+
+//-----------------------------------------------------------------------------
+class NavScheduleTest : public TestCase
+{
+public:
+  NavScheduleTest () : TestCase ("NavSchedule")
+  {
+  }
+  virtual void DoRun (void)
+  {
+    NavSchedule schedule;
+    NS_TEST_EXPECT_MSG_EQ (schedule.FindFreeSlot (MicroSeconds (5), MicroSeconds (10)), MicroSeconds (5), "empty schedule");
+
+    schedule.Add (MicroSeconds (10), MicroSeconds (20));
+    schedule.Add (MicroSeconds (40), MicroSeconds (50));
+    NS_TEST_EXPECT_MSG_EQ (schedule.GetN (), 2, "two reservations");
+    NS_TEST_EXPECT_MSG_EQ (schedule.GetEnd (), MicroSeconds (50), "end of the last reservation");
+
+    // the gap [20, 40] can hold 20us, a slot may begin at the end of the previous one
+    NS_TEST_EXPECT_MSG_EQ (schedule.FindFreeSlot (MicroSeconds (0), MicroSeconds (20)), MicroSeconds (20), "fits in the gap");
+    NS_TEST_EXPECT_MSG_EQ (schedule.FindFreeSlot (MicroSeconds (15), MicroSeconds (5)), MicroSeconds (20), "pushed after the covering slot");
+    NS_TEST_EXPECT_MSG_EQ (schedule.FindFreeSlot (MicroSeconds (0), MicroSeconds (25)), MicroSeconds (50), "too long for the gap");
+    NS_TEST_EXPECT_MSG_EQ (schedule.FindFreeSlot (MicroSeconds (0), MicroSeconds (5)), MicroSeconds (0), "fits before the first slot");
+
+    NS_TEST_EXPECT_MSG_EQ (schedule.IsFree (MicroSeconds (25), MicroSeconds (35)), true, "inside the gap");
+    NS_TEST_EXPECT_MSG_EQ (schedule.IsFree (MicroSeconds (20), MicroSeconds (30)), false, "starts at the end of a slot");
+    NS_TEST_EXPECT_MSG_EQ (schedule.IsFree (MicroSeconds (35), MicroSeconds (45)), false, "overlaps the next slot");
+
+    // overlapping reservations are merged
+    schedule.Add (MicroSeconds (18), MicroSeconds (42));
+    NS_TEST_EXPECT_MSG_EQ (schedule.GetN (), 1, "all merged");
+    NS_TEST_EXPECT_MSG_EQ (schedule.FindFreeSlot (MicroSeconds (0), MicroSeconds (20)), MicroSeconds (50), "no gap left");
+
+    schedule.Add (MicroSeconds (60), MicroSeconds (70));
+    schedule.Purge (MicroSeconds (55));
+    NS_TEST_EXPECT_MSG_EQ (schedule.GetN (), 1, "past reservation purged");
+    NS_TEST_EXPECT_MSG_EQ (schedule.GetEnd (), MicroSeconds (70), "future reservation kept");
+
+    // a NAV overheard on the data channel is a reservation of the data MAC
+    Ptr<MacLowData> low = CreateObject<MacLowData> ();
+    low->DoNavStartNow (MicroSeconds (15));
+    low->UpdateNav (MicroSeconds (18), MicroSeconds (4));
+    NS_TEST_EXPECT_MSG_EQ (low->GetNavSchedule ().GetEnd (), MicroSeconds (22), "end of the last reservation");
+    NS_TEST_EXPECT_MSG_EQ (low->GetNavSchedule ().IsFree (MicroSeconds (5), MicroSeconds (10)), false, "overheard NAV kept");
+    Simulator::Destroy ();
+  }
+};
+
+//-----------------------------------------------------------------------------
+class WifiMacQueueByAddressTest : public TestCase
+{
+public:
+  WifiMacQueueByAddressTest () : TestCase ("WifiMacQueue lookups by address")
+  {
+  }
+  virtual void DoRun (void)
+  {
+    Mac48Address a ("00:00:00:00:00:01");
+    Mac48Address b ("00:00:00:00:00:02");
+    Ptr<WifiMacQueue> queue = CreateObject<WifiMacQueue> ();
+    uint32_t sizes[] = { 100, 200, 300, 400 };
+    Mac48Address dests[] = { a, b, a, a };
+    for (uint32_t i = 0; i < 4; i++)
+      {
+        WifiMacHeader hdr;
+        hdr.SetType (WIFI_MAC_DATA);
+        hdr.SetAddr1 (dests[i]);
+        queue->Enqueue (Create<Packet> (sizes[i]), hdr);
+      }
+
+    std::vector<Ptr<const Packet> > packets;
+    std::vector<WifiMacHeader> hdrs;
+    NS_TEST_EXPECT_MSG_EQ (queue->PeekByAddress (packets, hdrs, WifiMacHeader::ADDR1, a, 2), 2, "limited to maxN");
+    NS_TEST_EXPECT_MSG_EQ (packets[0]->GetSize (), 100, "queue order");
+    NS_TEST_EXPECT_MSG_EQ (packets[1]->GetSize (), 300, "other receivers skipped");
+    NS_TEST_EXPECT_MSG_EQ (queue->GetSize (), 4, "peek keeps the packets");
+
+    WifiMacHeader hdr;
+    Ptr<const Packet> packet = queue->DequeueByAddress (&hdr, WifiMacHeader::ADDR1, b);
+    NS_TEST_EXPECT_MSG_EQ (packet->GetSize (), 200, "first packet to b");
+    NS_TEST_EXPECT_MSG_EQ (queue->DequeueByAddress (&hdr, WifiMacHeader::ADDR1, b), 0, "no more packet to b");
+    NS_TEST_EXPECT_MSG_EQ (queue->GetSize (), 3, "one packet removed");
+  }
+};
+
+//-----------------------------------------------------------------------------
+class WifiMacQueueIndexTest : public TestCase
+{
+public:
+  WifiMacQueueIndexTest () : TestCase ("WifiMacQueue indexes against a plain list")
+  {
+  }
+  virtual void DoRun (void)
+  {
+    m_queue = CreateObject<WifiMacQueue> ();
+    m_queue->SetMaxSize (50);
+    m_queue->SetMaxDelay (MilliSeconds (30));
+    m_queue->TraceConnectWithoutContext ("Depth", MakeCallback (&WifiMacQueueIndexTest::NotifyDepth, this));
+    m_queue->TraceConnectWithoutContext ("Sojourn", MakeCallback (&WifiMacQueueIndexTest::NotifySojourn, this));
+    m_depth = 0;
+    m_nSojourn = 0;
+    m_nSent = 0;
+    for (uint32_t i = 0; i < 4; i++)
+      {
+        m_addresses.push_back (Mac48Address::Allocate ());
+      }
+    for (uint32_t i = 0; i < 3000; i++)
+      {
+        Simulator::Schedule (MicroSeconds (200 * i), &WifiMacQueueIndexTest::DoOperation, this);
+      }
+    Simulator::Run ();
+    Simulator::Destroy ();
+    NS_TEST_EXPECT_MSG_EQ (m_nSojourn, m_nSent, "one sojourn per packet sent");
+    m_queue = 0;
+  }
+
+private:
+  struct Item
+  {
+    Ptr<const Packet> packet;
+    WifiMacHeader hdr;
+    Time tstamp;
+  };
+  typedef std::list<Item> Items;
+
+  void NotifyDepth (uint32_t oldValue, uint32_t newValue)
+  {
+    m_depth = newValue;
+  }
+  void NotifySojourn (Ptr<const Packet> packet, Time sojourn)
+  {
+    m_nSojourn++;
+  }
+  void Cleanup (void)
+  {
+    for (Items::iterator it = m_reference.begin (); it != m_reference.end ();)
+      {
+        if (it->tstamp + MilliSeconds (30) > Simulator::Now ())
+          {
+            ++it;
+          }
+        else
+          {
+            it = m_reference.erase (it);
+          }
+      }
+  }
+  bool Matches (const Item &item, Mac48Address address, bool qosTid, uint8_t tid)
+  {
+    return item.hdr.GetAddr1 () == address
+           && (!qosTid || (item.hdr.IsQosData () && item.hdr.GetQosTid () == tid));
+  }
+  Items::iterator Find (Mac48Address address, bool qosTid, uint8_t tid)
+  {
+    Items::iterator it = m_reference.begin ();
+    while (it != m_reference.end () && !Matches (*it, address, qosTid, tid))
+      {
+        ++it;
+      }
+    return it;
+  }
+  void Check (Ptr<const Packet> packet, const WifiMacHeader &hdr, Items::iterator expected, bool erase)
+  {
+    if (expected == m_reference.end ())
+      {
+        NS_TEST_EXPECT_MSG_EQ (packet, 0, "no packet expected at " << Simulator::Now ());
+        return;
+      }
+    NS_TEST_EXPECT_MSG_EQ (packet, expected->packet, "packet at " << Simulator::Now ());
+    NS_TEST_EXPECT_MSG_EQ (hdr.GetAddr1 (), expected->hdr.GetAddr1 (), "header at " << Simulator::Now ());
+    if (erase)
+      {
+        m_reference.erase (expected);
+        m_nSent++;
+      }
+  }
+  void DoOperation (void)
+  {
+    Cleanup ();
+    Mac48Address address = m_addresses[m_random.GetInteger (0, m_addresses.size () - 1)];
+    uint8_t tid = m_random.GetInteger (0, 2);
+    WifiMacHeader hdr;
+    Ptr<const Packet> packet;
+    uint32_t operation = m_random.GetInteger (0, 9);
+    if (operation <= 3)
+      {
+        Item item;
+        item.packet = Create<Packet> (100);
+        item.hdr.SetType (m_random.GetInteger (0, 1) ? WIFI_MAC_QOSDATA : WIFI_MAC_DATA);
+        item.hdr.SetAddr1 (address);
+        if (item.hdr.IsQosData ())
+          {
+            item.hdr.SetQosTid (tid);
+          }
+        item.tstamp = Simulator::Now ();
+        if (m_reference.size () < 50)
+          {
+            if (operation == 0)
+              {
+                m_reference.push_front (item);
+              }
+            else
+              {
+                m_reference.push_back (item);
+              }
+          }
+        if (operation == 0)
+          {
+            m_queue->PushFront (item.packet, item.hdr);
+          }
+        else
+          {
+            m_queue->Enqueue (item.packet, item.hdr);
+          }
+      }
+    else if (operation == 4)
+      {
+        packet = m_queue->Dequeue (&hdr);
+        Check (packet, hdr, m_reference.begin (), true);
+      }
+    else if (operation == 5)
+      {
+        packet = m_queue->DequeueByTidAndAddress (&hdr, tid, WifiMacHeader::ADDR1, address);
+        Check (packet, hdr, Find (address, true, tid), true);
+      }
+    else if (operation == 6)
+      {
+        packet = m_queue->PeekByTidAndAddress (&hdr, tid, WifiMacHeader::ADDR1, address);
+        Items::iterator expected = Find (address, true, tid);
+        Check (packet, hdr, expected, false);
+        if (packet != 0 && m_random.GetInteger (0, 1))
+          {
+            NS_TEST_EXPECT_MSG_EQ (m_queue->Remove (packet), true, "peeked packet removed");
+            Check (packet, hdr, expected, true);
+          }
+      }
+    else if (operation == 7)
+      {
+        packet = m_queue->DequeueByAddress (&hdr, WifiMacHeader::ADDR1, address);
+        Check (packet, hdr, Find (address, false, 0), true);
+      }
+    else if (operation == 8)
+      {
+        std::vector<Ptr<const Packet> > packets;
+        std::vector<WifiMacHeader> hdrs;
+        uint32_t n = m_queue->PeekByAddress (packets, hdrs, WifiMacHeader::ADDR1, address, 3);
+        uint32_t expected = 0;
+        for (Items::iterator it = m_reference.begin (); it != m_reference.end () && expected < 3; ++it)
+          {
+            if (Matches (*it, address, false, 0))
+              {
+                NS_TEST_EXPECT_MSG_EQ (packets[expected], it->packet, "packet " << expected << " at " << Simulator::Now ());
+                expected++;
+              }
+          }
+        NS_TEST_EXPECT_MSG_EQ (n, expected, "peeked packets at " << Simulator::Now ());
+      }
+    else
+      {
+        uint32_t expected = 0;
+        for (Items::iterator it = m_reference.begin (); it != m_reference.end (); ++it)
+          {
+            expected += Matches (*it, address, true, tid);
+          }
+        uint32_t n = m_queue->GetNPacketsByTidAndAddress (tid, WifiMacHeader::ADDR1, address);
+        NS_TEST_EXPECT_MSG_EQ (n, expected, "packets per TID at " << Simulator::Now ());
+      }
+    NS_TEST_EXPECT_MSG_EQ (m_queue->GetSize (), m_reference.size (), "size at " << Simulator::Now ());
+    NS_TEST_EXPECT_MSG_EQ (m_depth, m_reference.size (), "depth at " << Simulator::Now ());
+  }
+
+  Ptr<WifiMacQueue> m_queue;
+  Items m_reference;
+  std::vector<Mac48Address> m_addresses;
+  UniformVariable m_random;
+  uint32_t m_depth;
+  uint32_t m_nSojourn;
+  uint32_t m_nSent;
+};
+
+//-----------------------------------------------------------------------------
+class VccTraceRingTest : public TestCase
+{
+public:
+  VccTraceRingTest () : TestCase ("VccTraceRing")
+  {
+  }
+  virtual void DoRun (void)
+  {
+    Mac48Address a ("00:00:00:00:00:01");
+    Mac48Address b ("00:00:00:00:00:02");
+    Ptr<VccTraceRing> ring = CreateObject<VccTraceRing> ();
+    ring->SetCapacity (3);
+    NS_TEST_EXPECT_MSG_EQ (ring->GetCapacity (), 4, "rounded up to a power of two");
+
+    for (uint32_t i = 0; i < 6; i++)
+      {
+        ring->NotifyNavScheduled (a, b, MicroSeconds (i), MicroSeconds (10));
+      }
+    ring->NotifyReservationDropped (b, a, RESERVATION_DROP_LATE_CTS);
+    NS_TEST_EXPECT_MSG_EQ (ring->GetNRecorded (), 7, "all records counted");
+    NS_TEST_EXPECT_MSG_EQ (ring->GetN (), 4, "oldest records overwritten");
+    NS_TEST_EXPECT_MSG_EQ (ring->Get (0).start, MicroSeconds (3).GetNanoSeconds (), "oldest record kept");
+    NS_TEST_EXPECT_MSG_EQ ((uint32_t)ring->Get (3).event, (uint32_t)VccTraceRing::RESERVATION_DROPPED, "newest record last");
+
+    std::stringstream ss;
+    ring->Write (ss);
+    std::vector<VccTraceRing::Record> records;
+    NS_TEST_EXPECT_MSG_EQ (VccTraceRing::Read (ss, records), true, "complete trace");
+    NS_TEST_EXPECT_MSG_EQ (records.size (), 4, "all records read back");
+    NS_TEST_EXPECT_MSG_EQ (records[2].duration, MicroSeconds (10).GetNanoSeconds (), "duration read back");
+    NS_TEST_EXPECT_MSG_EQ ((uint32_t)records[3].reason, (uint32_t)RESERVATION_DROP_LATE_CTS, "reason read back");
+
+    std::stringstream truncated (ss.str ().substr (0, ss.str ().size () - 1));
+    records.clear ();
+    NS_TEST_EXPECT_MSG_EQ (VccTraceRing::Read (truncated, records), false, "truncated trace");
+
+    std::stringstream text;
+    VccTraceRing::Print (ring->Get (3), text);
+    bool found = text.str ().find ("RESERVATION_DROPPED self=00:00:00:00:00:02 peer=00:00:00:00:00:01 reason=LATE_CTS") != std::string::npos;
+    NS_TEST_EXPECT_MSG_EQ (found, true, "decoded text " << text.str ());
+  }
+};
+
+//-----------------------------------------------------------------------------
+/**
+ * Replay a random sequence of overlapping frames through an
+ * InterferenceHelper and through a copy of the original vector based
+ * algorithm, which folds the past nichanges only when a frame is added
+ * out of a reception and rescans all of them on every query. Both must
+ * agree bit for bit.
+ */
+class InterferenceHelperIncrementalTest : public TestCase
+{
+public:
+  InterferenceHelperIncrementalTest ();
+  virtual void DoRun (void);
+private:
+  typedef std::vector<std::pair<Time, double> > NiChanges;
+
+  void Step (uint32_t remaining);
+  void EndRx (Ptr<InterferenceHelper::Event> event);
+  void RefAdd (Ptr<InterferenceHelper::Event> event);
+  void RefInsert (Time time, double delta);
+  Time RefGetEnergyDuration (double energyW) const;
+  double RefCalculateChunkSuccessRate (double noiseW, double powerW, Time duration, WifiMode mode) const;
+  InterferenceHelper::SnrPer RefCalculateSnrPer (Ptr<InterferenceHelper::Event> event) const;
+
+  InterferenceHelper m_helper;
+  Ptr<ErrorRateModel> m_model;
+  double m_noiseFigure;
+  NiChanges m_ref;
+  double m_refFirstPower;
+  bool m_rxing;
+  UniformVariable m_random;
+  uint32_t m_nRx;
+};
+
+static bool
+NiChangeTimeLess (const std::pair<Time, double> &a, const std::pair<Time, double> &b)
+{
+  return a.first < b.first;
+}
+
+InterferenceHelperIncrementalTest::InterferenceHelperIncrementalTest ()
+  : TestCase ("InterferenceHelper incremental accumulator matches the full rescan"),
+    m_noiseFigure (5.01187),
+    m_refFirstPower (0.0),
+    m_rxing (false),
+    m_nRx (0)
+{
+}
+
+void
+InterferenceHelperIncrementalTest::RefInsert (Time time, double delta)
+{
+  std::pair<Time, double> change (time, delta);
+  m_ref.insert (std::upper_bound (m_ref.begin (), m_ref.end (), change, NiChangeTimeLess), change);
+}
+
+void
+InterferenceHelperIncrementalTest::RefAdd (Ptr<InterferenceHelper::Event> event)
+{
+  if (!m_rxing)
+    {
+      std::pair<Time, double> now (Simulator::Now (), 0);
+      NiChanges::iterator nowIterator = std::upper_bound (m_ref.begin (), m_ref.end (), now, NiChangeTimeLess);
+      for (NiChanges::iterator i = m_ref.begin (); i != nowIterator; i++)
+        {
+          m_refFirstPower += i->second;
+        }
+      m_ref.erase (m_ref.begin (), nowIterator);
+      m_ref.insert (m_ref.begin (), std::make_pair (event->GetStartTime (), event->GetRxPowerW ()));
+    }
+  else
+    {
+      RefInsert (event->GetStartTime (), event->GetRxPowerW ());
+    }
+  RefInsert (event->GetEndTime (), -event->GetRxPowerW ());
+}
+
+Time
+InterferenceHelperIncrementalTest::RefGetEnergyDuration (double energyW) const
+{
+  Time now = Simulator::Now ();
+  double noiseInterferenceW = m_refFirstPower;
+  Time end = now;
+  for (NiChanges::const_iterator i = m_ref.begin (); i != m_ref.end (); i++)
+    {
+      noiseInterferenceW += i->second;
+      end = i->first;
+      if (end < now)
+        {
+          continue;
+        }
+      if (noiseInterferenceW < energyW)
+        {
+          break;
+        }
+    }
+  return end > now ? end - now : MicroSeconds (0);
+}
+
+double
+InterferenceHelperIncrementalTest::RefCalculateChunkSuccessRate (double noiseW, double powerW, Time duration, WifiMode mode) const
+{
+  if (duration == NanoSeconds (0))
+    {
+      return 1.0;
+    }
+  double noise = m_noiseFigure * (1.3803e-23 * 290.0 * mode.GetBandwidth ()) + noiseW;
+  uint64_t nbits = (uint64_t)(mode.GetPhyRate () * duration.GetSeconds ());
+  return m_model->GetChunkSuccessRate (mode, powerW / noise, (uint32_t)nbits);
+}
+
+InterferenceHelper::SnrPer
+InterferenceHelperIncrementalTest::RefCalculateSnrPer (Ptr<InterferenceHelper::Event> event) const
+{
+  NiChanges ni;
+  ni.push_back (std::make_pair (event->GetStartTime (), m_refFirstPower));
+  for (NiChanges::const_iterator i = m_ref.begin () + 1; i != m_ref.end (); i++)
+    {
+      if (event->GetEndTime () == i->first && event->GetRxPowerW () == -i->second)
+        {
+          break;
+        }
+      ni.push_back (*i);
+    }
+  ni.push_back (std::make_pair (event->GetEndTime (), 0.0));
+
+  WifiMode payloadMode = event->GetPayloadMode ();
+  WifiPreamble preamble = event->GetPreambleType ();
+  WifiMode headerMode = WifiPhy::GetPlcpHeaderMode (payloadMode, preamble);
+  Time headerStart = ni[0].first + MicroSeconds (WifiPhy::GetPlcpPreambleDurationMicroSeconds (payloadMode, preamble));
+  Time payloadStart = headerStart + MicroSeconds (WifiPhy::GetPlcpHeaderDurationMicroSeconds (payloadMode, preamble));
+  double powerW = event->GetRxPowerW ();
+  double noiseW = ni[0].second;
+  Time previous = ni[0].first;
+  double psr = 1.0;
+  for (uint32_t k = 1; k < ni.size (); k++)
+    {
+      Time current = ni[k].first;
+      if (previous >= payloadStart)
+        {
+          psr *= RefCalculateChunkSuccessRate (noiseW, powerW, current - previous, payloadMode);
+        }
+      else if (previous >= headerStart)
+        {
+          if (current >= payloadStart)
+            {
+              psr *= RefCalculateChunkSuccessRate (noiseW, powerW, payloadStart - previous, headerMode);
+              psr *= RefCalculateChunkSuccessRate (noiseW, powerW, current - payloadStart, payloadMode);
+            }
+          else
+            {
+              psr *= RefCalculateChunkSuccessRate (noiseW, powerW, current - previous, headerMode);
+            }
+        }
+      else if (current >= payloadStart)
+        {
+          psr *= RefCalculateChunkSuccessRate (noiseW, powerW, payloadStart - headerStart, headerMode);
+          psr *= RefCalculateChunkSuccessRate (noiseW, powerW, current - payloadStart, payloadMode);
+        }
+      else if (current >= headerStart)
+        {
+          psr *= RefCalculateChunkSuccessRate (noiseW, powerW, current - headerStart, headerMode);
+        }
+      noiseW += ni[k].second;
+      previous = current;
+    }
+
+  InterferenceHelper::SnrPer snrPer;
+  snrPer.snr = powerW / (m_noiseFigure * (1.3803e-23 * 290.0 * payloadMode.GetBandwidth ()) + ni[0].second);
+  snrPer.per = 1 - psr;
+  return snrPer;
+}
+
+void
+InterferenceHelperIncrementalTest::EndRx (Ptr<InterferenceHelper::Event> event)
+{
+  InterferenceHelper::SnrPer snrPer = m_helper.CalculateSnrPer (event);
+  InterferenceHelper::SnrPer refSnrPer = RefCalculateSnrPer (event);
+  NS_TEST_EXPECT_MSG_EQ (snrPer.snr, refSnrPer.snr, "snr at " << Simulator::Now ());
+  NS_TEST_EXPECT_MSG_EQ (snrPer.per, refSnrPer.per, "per at " << Simulator::Now ());
+  m_helper.NotifyRxEnd ();
+  m_rxing = false;
+  m_nRx++;
+}
+
+void
+InterferenceHelperIncrementalTest::Step (uint32_t remaining)
+{
+  double energyW = m_random.GetValue (1e-12, 1e-9);
+  Time duration = m_helper.GetEnergyDuration (energyW);
+  Time refDuration = RefGetEnergyDuration (energyW);
+  NS_TEST_EXPECT_MSG_EQ (duration, refDuration, "energy duration at " << Simulator::Now ());
+
+  if (m_random.GetValue () < 0.7)
+    {
+      WifiMode mode = m_random.GetValue () < 0.5 ? WifiPhy::GetOfdmRate6Mbps () : WifiPhy::GetOfdmRate54Mbps ();
+      uint32_t size = m_random.GetInteger (14, 1500);
+      double powerW = m_random.GetValue (1e-11, 1e-8);
+      Ptr<InterferenceHelper::Event> event = m_helper.Add (size, mode, WIFI_PREAMBLE_LONG,
+                                                           WifiPhy::CalculateTxDuration (size, mode, WIFI_PREAMBLE_LONG),
+                                                           powerW);
+      RefAdd (event);
+      if (!m_rxing && m_random.GetValue () < 0.5)
+        {
+          m_helper.NotifyRxStart ();
+          m_rxing = true;
+          Simulator::Schedule (event->GetDuration (), &InterferenceHelperIncrementalTest::EndRx, this, event);
+        }
+    }
+  if (remaining > 0)
+    {
+      // frames often start at the same time
+      Time delay = m_random.GetValue () < 0.2 ? Seconds (0) : MicroSeconds (m_random.GetInteger (1, 400));
+      Simulator::Schedule (delay, &InterferenceHelperIncrementalTest::Step, this, remaining - 1);
+    }
+}
+
+void
+InterferenceHelperIncrementalTest::DoRun (void)
+{
+  m_model = CreateObject<NistErrorRateModel> ();
+  m_helper.SetErrorRateModel (m_model);
+  m_helper.SetNoiseFigure (m_noiseFigure);
+  Simulator::Schedule (Seconds (1), &InterferenceHelperIncrementalTest::Step, this, 5000);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  NS_TEST_EXPECT_MSG_GT (m_nRx, 100, "enough receptions compared");
+}
+
+//-----------------------------------------------------------------------------
+class TableErrorRateModelTest : public TestCase
+{
+public:
+  TableErrorRateModelTest () : TestCase ("TableErrorRateModel against the closed form")
+  {
+  }
+  virtual void DoRun (void)
+  {
+    Ptr<TableErrorRateModel> table = CreateObject<TableErrorRateModel> ();
+    Ptr<NistErrorRateModel> nist = CreateObject<NistErrorRateModel> ();
+    WifiMode modes[] = { WifiPhy::GetOfdmRate6Mbps (), WifiPhy::GetOfdmRate54Mbps (), WifiPhy::GetDsssRate11Mbps () };
+    for (uint32_t i = 0; i < 3; i++)
+      {
+        double error = table->GetMaxError (modes[i], 1500 * 8);
+        NS_TEST_EXPECT_MSG_LT (error, 1e-3, modes[i]);
+      }
+
+    // out of the grid, the closed form is used
+    WifiMode mode = WifiPhy::GetOfdmRate6Mbps ();
+    double low = table->GetChunkSuccessRate (mode, 0.05, 100);
+    double exact = nist->GetChunkSuccessRate (mode, 0.05, 100);
+    NS_TEST_EXPECT_MSG_EQ (low, exact, "below the grid");
+    double high = table->GetChunkSuccessRate (mode, 1e6, 100);
+    NS_TEST_EXPECT_MSG_EQ (high, 1.0, "above the grid");
+
+    table->SetAttribute ("Model", StringValue ("ns3::YansErrorRateModel"));
+    double error = table->GetMaxError (mode, 1500 * 8);
+    NS_TEST_EXPECT_MSG_LT (error, 1e-3, "yans");
+
+    std::string filename = CreateTempDirFilename ("error-rate-table.txt");
+    NS_TEST_EXPECT_MSG_EQ (table->Save (filename), true, "tables written");
+    NS_TEST_EXPECT_MSG_EQ (TableErrorRateModel::Load (filename), true, "tables read back");
+    NS_TEST_EXPECT_MSG_EQ (TableErrorRateModel::Load (filename + ".none"), false, "no such file");
+
+    // a new grid is not served from the tables of the old one
+    Ptr<YansErrorRateModel> yans = CreateObject<YansErrorRateModel> ();
+    table->SetAttribute ("MinSnr", DoubleValue (0.0));
+    NS_TEST_EXPECT_MSG_EQ (table->GetChunkSuccessRate (mode, 0.5, 100),
+                           yans->GetChunkSuccessRate (mode, 0.5, 100), "below the new grid");
+  }
+};
+
+//-----------------------------------------------------------------------------
+class WifiRemoteStationLookupTest : public TestCase
+{
+public:
+  WifiRemoteStationLookupTest () : TestCase ("WifiRemoteStationManager lookups by address and TID")
+  {
+  }
+  virtual void DoRun (void)
+  {
+    Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+    phy->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+    ObjectFactory factory;
+    factory.SetTypeId ("ns3::ConstantRateWifiManager");
+    factory.Set ("MaxSsrc", UintegerValue (2));
+    Ptr<WifiRemoteStationManager> manager = factory.Create<WifiRemoteStationManager> ();
+    manager->SetupPhy (phy);
+
+    std::vector<Mac48Address> addresses;
+    for (uint32_t i = 0; i < 200; i++)
+      {
+        addresses.push_back (Mac48Address::Allocate ());
+        if (i % 2 == 0)
+          {
+            manager->RecordWaitAssocTxOk (addresses[i]);
+          }
+      }
+    for (uint32_t i = 0; i < 200; i++)
+      {
+        NS_TEST_EXPECT_MSG_EQ (manager->IsWaitAssocTxOk (addresses[i]), (i % 2 == 0), "state of " << addresses[i]);
+      }
+
+    // the retry counters are kept per address and TID
+    WifiMacHeader data;
+    data.SetType (WIFI_MAC_DATA);
+    WifiMacHeader qos;
+    qos.SetType (WIFI_MAC_QOSDATA);
+    qos.SetQosTid (5);
+    Ptr<Packet> packet = Create<Packet> (1000);
+    manager->ReportRtsFailed (addresses[0], &data);
+    manager->ReportRtsFailed (addresses[1], &data);
+    manager->ReportRtsFailed (addresses[0], &data);
+    NS_TEST_EXPECT_MSG_EQ (manager->NeedRtsRetransmission (addresses[0], &data, packet), false, "two failures");
+    NS_TEST_EXPECT_MSG_EQ (manager->NeedRtsRetransmission (addresses[0], &qos, packet), true, "other TID");
+    NS_TEST_EXPECT_MSG_EQ (manager->NeedRtsRetransmission (addresses[1], &data, packet), true, "one failure");
+
+    manager->Reset ();
+    NS_TEST_EXPECT_MSG_EQ (manager->NeedRtsRetransmission (addresses[0], &data, packet), true, "counters reset");
+    NS_TEST_EXPECT_MSG_EQ (manager->IsWaitAssocTxOk (addresses[0]), true, "states kept");
+    manager->Dispose ();
+  }
+};
+
+//-----------------------------------------------------------------------------
+class DataDcaTxopBurstTest : public TestCase
+{
+public:
+  DataDcaTxopBurstTest () : TestCase ("The packets sent in a slot reserved by a CTS")
+  {
+  }
+  virtual void DoRun (void)
+  {
+    // a burst of 3 to b, then the packet to c through the DCF
+    RunOne ("cbbbb", 3, false);
+    NS_TEST_EXPECT_MSG_EQ (m_sent, "bbbcb", "3 packets to b in the burst");
+    NS_TEST_EXPECT_MSG_EQ (m_drops, 0, "no drop");
+
+    // the queue runs out of packets to b before the end of the burst
+    RunOne ("cbb", 3, false);
+    NS_TEST_EXPECT_MSG_EQ (m_sent, "bbc", "the burst does not go on to c");
+    NS_TEST_EXPECT_MSG_EQ (m_drops, 1, "rest of the burst dropped");
+
+    // a retransmission to c takes the slot reserved for b
+    RunOne ("bb", 3, true);
+    NS_TEST_EXPECT_MSG_EQ (m_sent, "cbb", "no burst after the packet to c");
+    NS_TEST_EXPECT_MSG_EQ (m_drops, 1, "burst dropped");
+  }
+
+private:
+  Ptr<WifiNetDevice> CreateOne (Vector pos, Ptr<YansWifiChannel> channel)
+  {
+    Ptr<Node> node = CreateObject<Node> ();
+    Ptr<WifiNetDevice> dev = CreateObject<WifiNetDevice> ();
+    ObjectFactory factory;
+    factory.SetTypeId ("ns3::StaDataWifiMac");
+    factory.Set ("ActiveProbing", BooleanValue (false));
+    Ptr<WifiMac> mac = factory.Create<WifiMac> ();
+    mac->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+    Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+    Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+    phy->SetErrorRateModel (CreateObject<YansErrorRateModel> ());
+    phy->SetChannel (channel);
+    phy->SetDevice (dev);
+    phy->SetMobility (node);
+    phy->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+    mobility->SetPosition (pos);
+    node->AggregateObject (mobility);
+    mac->SetAddress (Mac48Address::Allocate ());
+    dev->SetMac (mac);
+    dev->SetPhy (phy);
+    dev->SetRemoteStationManager (CreateObject<ConstantRateWifiManager> ());
+    node->AddDevice (dev);
+    return dev;
+  }
+  WifiMacHeader MakeHeader (Mac48Address to)
+  {
+    WifiMacHeader hdr;
+    hdr.SetTypeData ();
+    hdr.SetAddr1 (to);
+    hdr.SetAddr2 (m_self);
+    hdr.SetAddr3 (to);
+    hdr.SetDsNotFrom ();
+    hdr.SetDsNotTo ();
+    return hdr;
+  }
+  /*
+   * queue a packet to b or to c for each letter of queued, as if a CTS
+   * reserved burst packets to b, and send them at 1 s
+   */
+  void RunOne (std::string queued, uint32_t burst, bool retransmission)
+  {
+    Ptr<YansWifiChannel> channel = CreateObject<YansWifiChannel> ();
+    channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+    channel->SetPropagationLossModel (CreateObject<LogDistancePropagationLossModel> ());
+    Ptr<WifiNetDevice> a = CreateOne (Vector (0.0, 0.0, 0.0), channel);
+    Ptr<WifiNetDevice> b = CreateOne (Vector (5.0, 0.0, 0.0), channel);
+    Ptr<WifiNetDevice> c = CreateOne (Vector (0.0, 5.0, 0.0), channel);
+    m_self = Mac48Address::ConvertFrom (a->GetAddress ());
+    m_b = Mac48Address::ConvertFrom (b->GetAddress ());
+    m_c = Mac48Address::ConvertFrom (c->GetAddress ());
+    m_sent = "";
+    m_drops = 0;
+    a->GetPhy ()->TraceConnectWithoutContext ("PhyTxBegin", MakeCallback (&DataDcaTxopBurstTest::TxBegin, this));
+
+    Ptr<DataDcaTxop> dca = DynamicCast<RegularDataWifiMac> (a->GetMac ())->m_dca;
+    dca->TraceConnectWithoutContext ("ReservationDropped", MakeCallback (&DataDcaTxopBurstTest::Dropped, this));
+    // the DCF leaves the queue alone while the reservation is pending
+    dca->m_bRequestAccessSucceeded = true;
+    dca->m_burstReceiver = m_b;
+    dca->m_pendingBurstLength = burst;
+    for (uint32_t i = 0; i < queued.size (); i++)
+      {
+        dca->Queue (Create<Packet> (1000), MakeHeader (queued[i] == 'b' ? m_b : m_c));
+      }
+    if (retransmission)
+      {
+        dca->m_currentPacket = Create<Packet> (1000);
+        dca->m_currentHdr = MakeHeader (m_c);
+      }
+    Simulator::Schedule (Seconds (1.0), &DataDcaTxop::SendPacketAsScheduled, dca);
+    Simulator::Run ();
+    Simulator::Destroy ();
+  }
+  void TxBegin (Ptr<const Packet> packet)
+  {
+    WifiMacHeader hdr;
+    packet->PeekHeader (hdr);
+    if (hdr.IsData ())
+      {
+        m_sent += hdr.GetAddr1 () == m_b ? 'b' : 'c';
+      }
+  }
+  void Dropped (Mac48Address receiver, ReservationDropReason reason)
+  {
+    NS_TEST_EXPECT_MSG_EQ (receiver, m_b, "drop of the reservation to b");
+    NS_TEST_EXPECT_MSG_EQ (reason, RESERVATION_DROP_BURST, "burst dropped");
+    m_drops++;
+  }
+
+  Mac48Address m_self;
+  Mac48Address m_b;
+  Mac48Address m_c;
+  std::string m_sent;
+  uint32_t m_drops;
+};
+
+//-----------------------------------------------------------------------------
+class MinstrelStationsTest : public TestCase
+{
+public:
+  MinstrelStationsTest () : TestCase ("Minstrel keeps the statistics of each station")
+  {
+  }
+  virtual void DoRun (void)
+  {
+    Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+    phy->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+    m_manager = CreateObject<MinstrelWifiManager> ();
+    m_manager->SetupPhy (phy);
+    m_good = Mac48Address::Allocate ();
+    m_bad = Mac48Address::Allocate ();
+    for (uint32_t i = 0; i < phy->GetNModes (); i++)
+      {
+        m_manager->AddSupportedMode (m_good, phy->GetMode (i));
+        m_manager->AddSupportedMode (m_bad, phy->GetMode (i));
+      }
+    for (uint32_t i = 0; i < 500; i++)
+      {
+        Simulator::Schedule (MilliSeconds (2 * i), &MinstrelStationsTest::Send, this);
+      }
+    Simulator::Run ();
+    Simulator::Destroy ();
+
+    uint64_t good = m_goodMode.GetDataRate ();
+    uint64_t bad = m_badMode.GetDataRate ();
+    NS_TEST_EXPECT_MSG_EQ (bad, phy->GetMode (0).GetDataRate (), "no success, lowest rate");
+    NS_TEST_EXPECT_MSG_GT (good, bad, "the failures of the other station are not counted");
+    m_manager->Dispose ();
+    m_manager = 0;
+  }
+
+private:
+  void Send (void)
+  {
+    WifiMacHeader hdr;
+    hdr.SetType (WIFI_MAC_DATA);
+    Ptr<Packet> packet = Create<Packet> (1000);
+    m_badMode = m_manager->GetDataMode (m_bad, &hdr, packet, 1028);
+    m_manager->ReportDataFailed (m_bad, &hdr);
+    m_manager->ReportFinalDataFailed (m_bad, &hdr);
+    m_goodMode = m_manager->GetDataMode (m_good, &hdr, packet, 1028);
+    m_manager->ReportDataOk (m_good, &hdr, 100.0, m_goodMode, 100.0);
+  }
+
+  Ptr<WifiRemoteStationManager> m_manager;
+  Mac48Address m_good;
+  Mac48Address m_bad;
+  WifiMode m_goodMode;
+  WifiMode m_badMode;
+};
+
 //-----------------------------------------------------------------------------
 
 class WifiTestSuite : public TestSuite
@@ -442,6 +1596,19 @@ WifiTestSuite::WifiTestSuite ()
   AddTestCase (new QosUtilsIsOldPacketTest);
   AddTestCase (new InterferenceHelperSequenceTest); // Bug 991
   AddTestCase (new Bug555TestCase); // Bug 555
+  AddTestCase (new YansWifiChannelPartitionTest);
+  AddTestCase (new YansWifiChannelCutoffTest);
+  AddTestCase (new ChannelAddressRegistryTest);
+  AddTestCase (new CtrlRtsArbiterTest);
+  AddTestCase (new NavScheduleTest);
+  AddTestCase (new WifiMacQueueByAddressTest);
+  AddTestCase (new WifiMacQueueIndexTest);
+  AddTestCase (new VccTraceRingTest);
+  AddTestCase (new InterferenceHelperIncrementalTest);
+  AddTestCase (new TableErrorRateModelTest);
+  AddTestCase (new WifiRemoteStationLookupTest);
+  AddTestCase (new MinstrelStationsTest);
+  AddTestCase (new DataDcaTxopBurstTest);
 }
 
 static WifiTestSuite g_wifiTestSuite;
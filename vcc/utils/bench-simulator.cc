@@ -34,6 +34,7 @@ class Bench
 public:
   Bench ();
   void ReadDistribution (std::istream &istream);
+  void WifiDistribution (uint32_t size);
   void SetTotal (uint32_t total);
   void RunBench (void);
 private:
@@ -75,6 +76,40 @@ Bench::ReadDistribution (std::istream &input)
     }
 }
 
+/* the delays of the events of a busy 802.11a network: mostly IFS,
+ * backoffs and timeouts, a quarter of frame durations and a few
+ * beacons and application timers */
+void
+Bench::WifiDistribution (uint32_t size)
+{
+  UniformVariable rng;
+  for (uint32_t i = 0; i < size; i++)
+    {
+      double x = rng.GetValue ();
+      uint64_t us;
+      if (x < 0.4)
+        {
+          // DIFS and a backoff, with a contention window from 15 to 1023
+          uint32_t cw = (16 << rng.GetInteger (0, 6)) - 1;
+          us = 34 + 9 * rng.GetInteger (0, cw);
+        }
+      else if (x < 0.7)
+        {
+          // SIFS or an ACK timeout
+          us = rng.GetValue () < 0.5 ? 16 : 75;
+        }
+      else if (x < 0.95)
+        {
+          us = rng.GetInteger (100, 2500);
+        }
+      else
+        {
+          us = rng.GetValue () < 0.5 ? 102400 : 1000000;
+        }
+      m_distribution.push_back (us * 1000);
+    }
+}
+
 void
 Bench::RunBench (void) 
 {
@@ -130,11 +165,17 @@ void
 PrintHelp (void)
 {
   std::cout << "bench-simulator filename [options]"<<std::endl;
-  std::cout << "  filename: a string which identifies the input distribution. \"-\" represents stdin." << std::endl;
+  std::cout << "  filename: a string which identifies the input distribution. \"-\" represents stdin," << std::endl;
+  std::cout << "            \"wifi\" the delays of the events of a busy wifi network." << std::endl;
   std::cout << "  Options:"<<std::endl;
   std::cout << "      --list: use std::list scheduler"<<std::endl;
   std::cout << "      --map: use std::map cheduler"<<std::endl;
   std::cout << "      --heap: use Binary Heap scheduler"<<std::endl;
+  std::cout << "      --calendar: use Calendar Queue scheduler"<<std::endl;
+  std::cout << "      --ladder: use Ladder Queue scheduler"<<std::endl;
+  std::cout << "      --total=n: the number of events to run"<<std::endl;
+  std::cout << "      --n=n: the number of runs"<<std::endl;
+  std::cout << "      --size=n: the number of events of the wifi distribution"<<std::endl;
   std::cout << "      --debug: enable some debugging"<<std::endl;
 }
 
@@ -144,6 +185,7 @@ int main (int argc, char *argv[])
   std::istream *input;
   uint32_t n = 1;
   uint32_t total = 20000;
+  uint32_t size = 100000;
   if (argc == 1)
     {
       PrintHelp ();
@@ -155,6 +197,10 @@ int main (int argc, char *argv[])
     {
       input = &std::cin;
     } 
+  else if (strcmp (filename, "wifi") == 0)
+    {
+      input = 0;
+    }
   else 
     {
       input = new std::ifstream (filename);
@@ -174,7 +220,7 @@ int main (int argc, char *argv[])
         } 
       else if (strcmp ("--map", argv[0]) == 0) 
         {
-          factory.SetTypeId ("ns3::HeapScheduler");
+          factory.SetTypeId ("ns3::MapScheduler");
           Simulator::SetScheduler (factory);
         } 
       else if (strcmp ("--calendar", argv[0]) == 0)
@@ -182,6 +228,11 @@ int main (int argc, char *argv[])
           factory.SetTypeId ("ns3::CalendarScheduler");
           Simulator::SetScheduler (factory);
         }
+      else if (strcmp ("--ladder", argv[0]) == 0)
+        {
+          factory.SetTypeId ("ns3::LadderScheduler");
+          Simulator::SetScheduler (factory);
+        }
       else if (strcmp ("--debug", argv[0]) == 0) 
         {
           g_debug = true;
@@ -194,12 +245,23 @@ int main (int argc, char *argv[])
         {
           n = atoi (argv[0]+strlen ("--n="));
         } 
+      else if (strncmp ("--size=", argv[0], strlen("--size=")) == 0)
+        {
+          size = atoi (argv[0]+strlen ("--size="));
+        }
 
       argc--;
       argv++;
   }
   Bench *bench = new Bench ();
-  bench->ReadDistribution (*input);
+  if (input == 0)
+    {
+      bench->WifiDistribution (size);
+    }
+  else
+    {
+      bench->ReadDistribution (*input);
+    }
   bench->SetTotal (total);
   for (uint32_t i = 0; i < n; i++)
     {
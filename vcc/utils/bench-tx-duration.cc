@@ -0,0 +1,95 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/command-line.h"
+#include "ns3/yans-wifi-phy.h"
+#include <iostream>
+
+using namespace ns3;
+
+// the frames of an RTS/CTS/DATA/ACK exchange, as computed by the MACs
+// for every NAV: sizes in bytes
+static const uint32_t g_sizes[] = { 20, 14, 1536, 14, 1536, 14 };
+static const uint32_t g_nSizes = sizeof (g_sizes) / sizeof (g_sizes[0]);
+
+static int64_t
+benchStatic (uint32_t n, const WifiMode *modes, uint32_t nModes)
+{
+  int64_t total = 0;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      WifiMode mode = modes[i % nModes];
+      for (uint32_t j = 0; j < g_nSizes; j++)
+        {
+          total += WifiPhy::CalculateTxDuration (g_sizes[j], mode, WIFI_PREAMBLE_LONG).GetMicroSeconds ();
+        }
+    }
+  return total;
+}
+
+static int64_t
+benchMemoized (uint32_t n, Ptr<WifiPhy> phy, const WifiMode *modes, uint32_t nModes)
+{
+  int64_t total = 0;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      WifiMode mode = modes[i % nModes];
+      for (uint32_t j = 0; j < g_nSizes; j++)
+        {
+          total += phy->GetTxDuration (g_sizes[j], mode, WIFI_PREAMBLE_LONG).GetMicroSeconds ();
+        }
+    }
+  return total;
+}
+
+static void
+report (char const *name, uint32_t n, uint64_t deltaMs)
+{
+  double cps = (double)n * g_nSizes * 1000;
+  cps /= deltaMs > 0 ? deltaMs : 1;
+  std::cout << name << "=" << cps << " calls/s (" << deltaMs << " ms)" << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 2000000;
+
+  CommandLine cmd;
+  cmd.AddValue ("n", "number of frame exchanges", n);
+  cmd.Parse (argc, argv);
+
+  WifiMode modes[] = { WifiPhy::GetOfdmRate6Mbps (), WifiPhy::GetOfdmRate54Mbps (),
+                       WifiPhy::GetDsssRate1Mbps (), WifiPhy::GetDsssRate11Mbps () };
+  uint32_t nModes = sizeof (modes) / sizeof (modes[0]);
+  Ptr<WifiPhy> phy = CreateObject<YansWifiPhy> ();
+  std::cout << "Running bench-tx-duration with n=" << n << std::endl;
+
+  SystemWallClockMs time;
+  time.Start ();
+  int64_t expected = benchStatic (n, modes, nModes);
+  report ("static", n, time.End ());
+
+  time.Start ();
+  int64_t total = benchMemoized (n, phy, modes, nModes);
+  report ("memoized", n, time.End ());
+
+  if (total != expected)
+    {
+      std::cerr << "memoized durations differ: " << total << " != " << expected << std::endl;
+      return 1;
+    }
+  return 0;
+}
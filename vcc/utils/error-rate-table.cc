@@ -0,0 +1,90 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ns3/table-error-rate-model.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/command-line.h"
+#include "ns3/string.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include <iostream>
+#include <vector>
+
+using namespace ns3;
+
+// build the tables of ns3::TableErrorRateModel for the 802.11a/b modes,
+// print their largest error against the closed form and save them.
+int main (int argc, char *argv[])
+{
+  std::string model = "ns3::NistErrorRateModel";
+  std::string output = "";
+  double minSnr = -10.0;
+  double maxSnr = 50.0;
+  uint32_t resolution = 20;
+
+  CommandLine cmd;
+  cmd.AddValue ("model", "the error rate model to interpolate", model);
+  cmd.AddValue ("output", "the file to save the tables to, none if empty", output);
+  cmd.AddValue ("minSnr", "the lowest SNR (dB) of the tables", minSnr);
+  cmd.AddValue ("maxSnr", "the highest SNR (dB) of the tables", maxSnr);
+  cmd.AddValue ("resolution", "the number of points of the tables per dB", resolution);
+  cmd.Parse (argc, argv);
+
+  Ptr<TableErrorRateModel> table = CreateObject<TableErrorRateModel> ();
+  table->SetAttribute ("Model", StringValue (model));
+  table->SetAttribute ("MinSnr", DoubleValue (minSnr));
+  table->SetAttribute ("MaxSnr", DoubleValue (maxSnr));
+  table->SetAttribute ("Resolution", UintegerValue (resolution));
+
+  std::vector<WifiMode> modes;
+  modes.push_back (WifiPhy::GetDsssRate1Mbps ());
+  modes.push_back (WifiPhy::GetDsssRate2Mbps ());
+  modes.push_back (WifiPhy::GetDsssRate5_5Mbps ());
+  modes.push_back (WifiPhy::GetDsssRate11Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate6Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate9Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate12Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate18Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate24Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate36Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate48Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate54Mbps ());
+
+  // the PLCP header, an ACK, a 1500 bytes frame
+  uint32_t nbits[] = { 24, 14 * 8, 1500 * 8 };
+  std::cout << "# max absolute error of the chunk success rate of " << model << std::endl;
+  std::cout << "# mode";
+  for (uint32_t j = 0; j < sizeof (nbits) / sizeof (nbits[0]); j++)
+    {
+      std::cout << " " << nbits[j] << "bits";
+    }
+  std::cout << std::endl;
+  for (std::vector<WifiMode>::const_iterator i = modes.begin (); i != modes.end (); ++i)
+    {
+      std::cout << i->GetUniqueName ();
+      for (uint32_t j = 0; j < sizeof (nbits) / sizeof (nbits[0]); j++)
+        {
+          std::cout << " " << table->GetMaxError (*i, nbits[j]);
+        }
+      std::cout << std::endl;
+    }
+
+  if (!output.empty () && !table->Save (output))
+    {
+      std::cerr << "can not write " << output << std::endl;
+      return 1;
+    }
+  return 0;
+}
@@ -0,0 +1,44 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ns3/vcc-trace-ring.h"
+#include <iostream>
+#include <fstream>
+
+using namespace ns3;
+
+// print a trace written by ns3::VccTraceRing::Write, one line per record
+int main (int argc, char *argv[])
+{
+  if (argc != 2)
+    {
+      std::cerr << "usage: " << argv[0] << " <trace file>" << std::endl;
+      return 1;
+    }
+
+  std::ifstream is (argv[1], std::ios::in | std::ios::binary);
+  if (!is.is_open ())
+    {
+      std::cerr << "can not open " << argv[1] << std::endl;
+      return 1;
+    }
+
+  if (!VccTraceRing::Decode (is, std::cout))
+    {
+      std::cerr << argv[1] << " is not a complete vcc trace" << std::endl;
+      return 1;
+    }
+  return 0;
+}